@@ -0,0 +1,98 @@
+// Copyright 2026 by Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Sort and shuffle vectors of optionals with 50% random engagement, comparing
+// a trivially copyable payload (branch-free swap and assignment) with an
+// equivalent payload that has user-provided copy operations (general path).
+
+#include "nonstd/optional.hpp"
+#include "bench.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using nonstd::optional;
+using nonstd::nullopt;
+
+struct Trivial
+{
+    long v;
+};
+
+struct NonTrivial
+{
+    long v;
+
+    NonTrivial( long x ) : v( x ) {}
+    NonTrivial( NonTrivial const & other ) : v( other.v ) {}
+    NonTrivial & operator=( NonTrivial const & other ) { v = other.v; return *this; }
+};
+
+inline bool operator<( Trivial    a, Trivial    b ) { return a.v < b.v; }
+inline bool operator<( NonTrivial a, NonTrivial b ) { return a.v < b.v; }
+
+template< typename T >
+std::vector< optional<T> > make_data( std::size_t n )
+{
+    std::mt19937_64 gen( 42 );
+    std::vector< optional<T> > data;
+
+    data.reserve( n );
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        long const r = static_cast<long>( gen() >> 1 );
+
+        if ( r & 1 ) data.push_back( T{ r >> 1 } );
+        else         data.push_back( nullopt );
+    }
+    return data;
+}
+
+template< typename T >
+void run( char const * name, std::size_t n )
+{
+    std::vector< optional<T> > const data = make_data<T>( n );
+    std::vector< optional<T> > work;
+    std::string label;
+
+    label = std::string( name ) + ": sort";
+    bench::measure( label.c_str(), [&]
+    {
+        work = data;
+        std::sort( work.begin(), work.end() );
+        bench::do_not_optimize( work.front() );
+    });
+
+    label = std::string( name ) + ": shuffle";
+    bench::measure( label.c_str(), [&]
+    {
+        std::mt19937_64 gen( 7 );
+        std::shuffle( work.begin(), work.end(), gen );
+        bench::do_not_optimize( work.front() );
+    });
+
+    label = std::string( name ) + ": copy-assign elements";
+    bench::measure( label.c_str(), [&]
+    {
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            work[i] = data[ n - 1 - i ];
+        }
+        bench::do_not_optimize( work.back() );
+    });
+}
+
+int main()
+{
+    std::size_t const n = 1000 * 1000;
+
+    run< Trivial    >( "optional<Trivial>   ", n );
+    run< NonTrivial >( "optional<NonTrivial>", n );
+}
+
+// g++ -std=c++11 -O2 -Doptional_CONFIG_SELECT_OPTIONAL=optional_OPTIONAL_NONSTD -I../include -o 01-trivial-swap-assign 01-trivial-swap-assign.cpp && ./01-trivial-swap-assign
@@ -0,0 +1,61 @@
+// Copyright 2026 by Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Grow vectors of optional<std::unique_ptr<int>> element by element, comparing
+// std::vector (move-construct and destroy per element on reallocation) with
+// nonstd::relocating_vector (memcpy on reallocation).
+
+#include "nonstd/optional_relocate.hpp"
+#include "bench.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using nonstd::optional;
+using nonstd::relocating_vector;
+
+typedef optional< std::unique_ptr<int> > element;
+
+template< typename Vector >
+void grow( std::size_t n, std::size_t rounds )
+{
+    for ( std::size_t r = 0; r < rounds; ++r )
+    {
+        Vector v;
+
+        // engaged with a null pointer, to measure the container rather than the heap:
+
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            if ( i % 2 ) v.emplace_back( std::unique_ptr<int>() );
+            else         v.emplace_back();
+        }
+        bench::do_not_optimize( v.back() );
+    }
+}
+
+template< typename Vector >
+void run( char const * name )
+{
+    std::size_t const total = 16 * 1000 * 1000;
+
+    for ( std::size_t n = 1000; n <= total / 16; n *= 10 )
+    {
+        std::string const label = std::string( name ) + ": grow to " + std::to_string( n );
+
+        bench::measure( label.c_str(), [&]{ grow< Vector >( n, total / n ); } );
+    }
+}
+
+int main()
+{
+    run< std::vector<element>       >( "std::vector      " );
+    run< relocating_vector<element> >( "relocating_vector" );
+}
+
+// g++ -std=c++11 -O2 -Doptional_CONFIG_SELECT_OPTIONAL=optional_OPTIONAL_NONSTD -I../include -o 02-relocate-vector 02-relocate-vector.cpp && ./02-relocate-vector
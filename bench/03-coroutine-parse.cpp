@@ -0,0 +1,129 @@
+// Copyright 2026 by Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Parse comma-separated triples of digits into the sum of their values, on
+// valid and on malformed input, propagating failure by explicit early return,
+// by exceptions and by co_await in an optional-returning coroutine.
+
+#include "nonstd/optional_coroutine.hpp"
+#include "bench.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using nonstd::optional;
+using nonstd::nullopt;
+
+namespace {
+
+// early return:
+
+optional<int> digit( char c )
+{
+    if ( c < '0' || c > '9' )
+        return nullopt;
+    return c - '0';
+}
+
+optional<int> triple_early( char const * s )
+{
+    optional<int> const a = digit( s[0] ); if ( !a ) return nullopt;
+    optional<int> const b = digit( s[1] ); if ( !b ) return nullopt;
+    optional<int> const c = digit( s[2] ); if ( !c ) return nullopt;
+
+    return 100 * *a + 10 * *b + *c;
+}
+
+// exceptions:
+
+int digit_throw( char c )
+{
+    if ( c < '0' || c > '9' )
+        throw std::invalid_argument( "digit" );
+    return c - '0';
+}
+
+optional<int> triple_throw( char const * s )
+{
+    try
+    {
+        return 100 * digit_throw( s[0] ) + 10 * digit_throw( s[1] ) + digit_throw( s[2] );
+    }
+    catch ( std::invalid_argument const & )
+    {
+        return nullopt;
+    }
+}
+
+// coroutine:
+
+optional<int> triple_coro( char const * s )
+{
+    int const a = co_await digit( s[0] );
+    int const b = co_await digit( s[1] );
+    int const c = co_await digit( s[2] );
+
+    co_return 100 * a + 10 * b + c;
+}
+
+template< typename F >
+long sum( std::vector<std::string> const & input, F parse )
+{
+    long total = 0;
+
+    for ( auto const & s : input )
+    {
+        total += parse( s.c_str() ).value_or( -1 );
+    }
+    return total;
+}
+
+std::vector<std::string> make_input( std::size_t n, std::size_t malformed_every )
+{
+    std::vector<std::string> input;
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        std::string s = std::to_string( 100 + i % 900 );
+
+        if ( malformed_every && i % malformed_every == 0 )
+            s[1] = 'x';
+
+        input.push_back( s );
+    }
+    return input;
+}
+
+} // anonymous namespace
+
+int main()
+{
+    std::size_t const n = 1000 * 1000;
+
+    struct { char const * name; std::size_t malformed_every; } const cases[] =
+    {
+        { "valid"        , 0 },
+        { "1% malformed" , 100 },
+        { "all malformed", 1 },
+    };
+
+    for ( auto const & c : cases )
+    {
+        std::vector<std::string> const input = make_input( n, c.malformed_every );
+
+        std::string const early  = std::string( "early return: " ) + c.name;
+        std::string const throws = std::string( "exceptions  : " ) + c.name;
+        std::string const coro   = std::string( "coroutine   : " ) + c.name;
+
+        bench::measure( early.c_str() , [&]{ bench::do_not_optimize( sum( input, triple_early ) ); } );
+        bench::measure( throws.c_str(), [&]{ bench::do_not_optimize( sum( input, triple_throw ) ); } );
+        bench::measure( coro.c_str()  , [&]{ bench::do_not_optimize( sum( input, triple_coro  ) ); } );
+    }
+}
+
+// g++ -std=c++20 -O2 -Doptional_CONFIG_SELECT_OPTIONAL=optional_OPTIONAL_NONSTD -I../include -o 03-coroutine-parse 03-coroutine-parse.cpp && ./03-coroutine-parse
@@ -0,0 +1,91 @@
+// Copyright 2026 by Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Throw and catch bad_optional_access from value() of an empty optional on
+// several threads at once, comparing nonstd::bad_optional_access (derived
+// from std::exception, no allocation) with an exception derived from
+// std::logic_error (allocates its message with libstdc++).
+
+#include "nonstd/optional.hpp"
+#include "bench.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using nonstd::optional;
+
+namespace {
+
+struct logic_error_access : std::logic_error
+{
+    logic_error_access() : std::logic_error( "bad optional access" ) {}
+};
+
+int value_logic_error( optional<int> const & opt )
+{
+    if ( !opt )
+        throw logic_error_access();
+    return *opt;
+}
+
+int value_exception( optional<int> const & opt )
+{
+    return opt.value();
+}
+
+template< typename Exception, typename F >
+void storm( unsigned threads, std::size_t throws, F value )
+{
+    std::vector< std::thread > pool;
+
+    for ( unsigned t = 0; t < threads; ++t )
+    {
+        pool.emplace_back( [=]{
+            optional<int> const empty;
+            std::size_t caught = 0;
+
+            for ( std::size_t i = 0; i < throws; ++i )
+            {
+                try
+                {
+                    bench::do_not_optimize( value( empty ) );
+                }
+                catch ( Exception const & )
+                {
+                    ++caught;
+                }
+            }
+            bench::do_not_optimize( caught );
+        } );
+    }
+
+    for ( auto & thread : pool )
+    {
+        thread.join();
+    }
+}
+
+} // anonymous namespace
+
+int main()
+{
+    std::size_t const throws = 100 * 1000;
+    unsigned const hardware = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+
+    for ( unsigned threads = 1; threads <= hardware; threads *= 2 )
+    {
+        std::string const exc = "std::exception  : " + std::to_string( threads ) + " threads x 100k throws";
+        std::string const err = "std::logic_error: " + std::to_string( threads ) + " threads x 100k throws";
+
+        bench::measure( exc.c_str(), [&]{ storm< nonstd::bad_optional_access >( threads, throws, value_exception   ); } );
+        bench::measure( err.c_str(), [&]{ storm< logic_error_access          >( threads, throws, value_logic_error ); } );
+    }
+}
+
+// g++ -std=c++11 -O2 -pthread -Doptional_CONFIG_SELECT_OPTIONAL=optional_OPTIONAL_NONSTD -I../include -o 04-bad-access-throw 04-bad-access-throw.cpp && ./04-bad-access-throw
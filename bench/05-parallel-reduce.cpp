@@ -0,0 +1,59 @@
+// Copyright 2026 by Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Aggregate a column of optional<double>, one in ten empty, with the parallel
+// algorithms on 1, 2, 4, ... up to the number of hardware threads, compared
+// with a sequential loop.
+
+#include "nonstd/optional_parallel.hpp"
+#include "bench.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using nonstd::optional;
+namespace parallel = nonstd::parallel;
+
+int main()
+{
+    std::size_t const n = 16 * 1000 * 1000;
+
+    std::vector< optional<double> > column( n );
+    std::vector< optional<double> > out( n );
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        if ( i % 10 ) column[i] = static_cast<double>( i % 1000 ) / 7;
+    }
+
+    bench::measure( "sequential loop: sum", [&]
+    {
+        double sum = 0;
+        for ( auto const & x : column )
+        {
+            if ( x ) sum += *x;
+        }
+        bench::do_not_optimize( sum );
+    } );
+
+    unsigned const hardware = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+
+    for ( unsigned threads = 1; threads <= hardware; threads *= 2 )
+    {
+        std::string const t = " threads";
+        std::string const label = std::to_string( threads ) + t;
+
+        bench::measure( ( "count_engaged    : " + label ).c_str(), [&]{ bench::do_not_optimize( parallel::count_engaged( column.begin(), column.end(), threads ) ); } );
+        bench::measure( ( "sum_engaged      : " + label ).c_str(), [&]{ bench::do_not_optimize( parallel::sum_engaged  ( column.begin(), column.end(), threads ) ); } );
+        bench::measure( ( "max_engaged      : " + label ).c_str(), [&]{ bench::do_not_optimize( parallel::max_engaged  ( column.begin(), column.end(), threads ) ); } );
+        bench::measure( ( "transform_engaged: " + label ).c_str(), [&]{ parallel::transform_engaged( column.begin(), column.end(), out.begin(), []( double x ) { return 2 * x; }, threads ); bench::do_not_optimize( out[1] ); } );
+        bench::measure( ( "fill_empty       : " + label ).c_str(), [&]{ out = column; parallel::fill_empty( out.begin(), out.end(), 0.0, threads ); bench::do_not_optimize( out[0] ); } );
+    }
+}
+
+// g++ -std=c++11 -O2 -pthread -Doptional_CONFIG_SELECT_OPTIONAL=optional_OPTIONAL_NONSTD -I../include -o 05-parallel-reduce 05-parallel-reduce.cpp && ./05-parallel-reduce
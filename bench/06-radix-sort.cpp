@@ -0,0 +1,60 @@
+// Copyright 2026 by Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Sort vectors of optional<std::uint64_t> and optional<double>, one in ten
+// empty, with std::sort and operator<, with radix_sort and with
+// parallel::radix_sort on all hardware threads.
+
+#include "nonstd/optional_sort.hpp"
+#include "bench.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using nonstd::optional;
+
+namespace {
+
+template< typename T, typename Generate >
+std::vector< optional<T> > make_input( std::size_t n, Generate generate )
+{
+    std::mt19937_64 rng( 1 );
+    std::vector< optional<T> > v( n );
+
+    for ( auto & x : v )
+    {
+        if ( rng() % 10 ) x = generate( rng );
+    }
+    return v;
+}
+
+template< typename T >
+void run( char const * type, std::vector< optional<T> > const & input )
+{
+    std::vector< optional<T> > v;
+
+    std::string const label = std::string( type ) + ", " + std::to_string( input.size() / 1000000 ) + "M: ";
+
+    bench::measure( ( label + "std::sort           " ).c_str(), [&]{ v = input; std::sort( v.begin(), v.end() ); bench::do_not_optimize( v[0] ); }, 3 );
+    bench::measure( ( label + "radix_sort          " ).c_str(), [&]{ v = input; nonstd::radix_sort( v.begin(), v.end() ); bench::do_not_optimize( v[0] ); }, 3 );
+    bench::measure( ( label + "parallel::radix_sort" ).c_str(), [&]{ v = input; nonstd::parallel::radix_sort( v.begin(), v.end() ); bench::do_not_optimize( v[0] ); }, 3 );
+}
+
+} // anonymous namespace
+
+int main()
+{
+    std::size_t const n = 10 * 1000 * 1000;
+
+    run( "uint64_t", make_input<std::uint64_t>( n, []( std::mt19937_64 & r ) { return r(); } ) );
+    run( "double  ", make_input<double       >( n, []( std::mt19937_64 & r ) { return std::uniform_real_distribution<double>( -1e9, 1e9 )( r ); } ) );
+}
+
+// g++ -std=c++11 -O2 -pthread -Doptional_CONFIG_SELECT_OPTIONAL=optional_OPTIONAL_NONSTD -I../include -o 06-radix-sort 06-radix-sort.cpp && ./06-radix-sort
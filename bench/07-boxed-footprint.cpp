@@ -0,0 +1,81 @@
+// Copyright 2026 by Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Memory footprint and scan time of a vector of one million optionals of a
+// 512-byte payload, with one in a hundred engaged: inline optional<T> versus
+// boxed_optional<T> with the pool allocator and with std::allocator.
+
+#include "nonstd/optional_boxed.hpp"
+#include "bench.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using nonstd::optional;
+using nonstd::boxed_optional;
+
+namespace {
+
+struct Payload
+{
+    long id;
+    char data[ 512 - sizeof( long ) ];
+};
+
+std::size_t const n = 1000 * 1000;
+std::size_t const every = 100;
+
+template< typename Optional >
+void fill( std::vector<Optional> & v )
+{
+    v.clear();
+    v.resize( n );
+
+    for ( std::size_t i = 0; i < n; i += every )
+    {
+        v[i].emplace();
+        v[i]->id = static_cast<long>( i );
+    }
+}
+
+template< typename Optional >
+long scan( std::vector<Optional> const & v )
+{
+    long sum = 0;
+    for ( auto const & x : v )
+    {
+        if ( x ) sum += x->id;
+    }
+    return sum;
+}
+
+template< typename Optional >
+void run( char const * label, std::size_t payload_bytes )
+{
+    std::vector<Optional> v;
+
+    std::printf( "%s: %7.1f MB\n", label, ( n * sizeof( Optional ) + n / every * payload_bytes ) / 1e6 );
+
+    bench::measure( "  fill", [&]{ fill( v ); bench::do_not_optimize( v[0] ); }, 3 );
+    bench::measure( "  scan", [&]{ bench::do_not_optimize( scan( v ) ); }, 10 );
+}
+
+} // anonymous namespace
+
+int main()
+{
+    typedef nonstd::pool_allocator<Payload> pool;
+
+    run< optional<Payload> >( "optional<T>                      ", 0 );
+    run< boxed_optional<Payload> >( "boxed_optional<T>                ", sizeof( Payload ) );
+    run< boxed_optional<Payload, std::allocator<Payload> > >( "boxed_optional<T, std::allocator>", sizeof( Payload ) );
+
+    std::printf( "pool reserved: %.1f MB\n", pool::pool_reserved() / 1e6 );
+}
+
+// g++ -std=c++11 -O2 -pthread -Doptional_CONFIG_SELECT_OPTIONAL=optional_OPTIONAL_NONSTD -I../include -o 07-boxed-footprint 07-boxed-footprint.cpp && ./07-boxed-footprint
@@ -0,0 +1,119 @@
+// Copyright 2026 by Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Read a 256-byte optional snapshot on 1, 2, 4, ... up to twice the number of
+// hardware threads, while one writer replaces it every 50 microseconds:
+// optional<T> guarded by std::shared_timed_mutex versus shared_optional<T>.
+
+#include "nonstd/optional_shared.hpp"
+#include "bench.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using nonstd::optional;
+using nonstd::shared_optional;
+
+namespace {
+
+struct Snapshot
+{
+    long field[ 256 / sizeof( long ) ];
+};
+
+std::size_t const reads = 200 * 1000;
+
+class locked_optional
+{
+public:
+    optional<Snapshot> load() const
+    {
+        std::shared_lock<std::shared_timed_mutex> lock( mutex_ );
+        return value_;
+    }
+
+    void store( Snapshot const & s )
+    {
+        std::unique_lock<std::shared_timed_mutex> lock( mutex_ );
+        value_ = s;
+    }
+
+private:
+    mutable std::shared_timed_mutex mutex_;
+    optional<Snapshot> value_;
+};
+
+// total reads per microsecond of readers threads, with a writer:
+
+template< typename Shared >
+void run( char const * label, unsigned readers )
+{
+    Shared shared;
+    std::atomic<bool> done( false );
+
+    std::thread writer( [&]
+    {
+        Snapshot s = {};
+        while ( !done.load() )
+        {
+            ++s.field[0];
+            shared.store( s );
+            std::this_thread::sleep_for( std::chrono::microseconds( 50 ) );
+        }
+    } );
+
+    std::string const name = std::string( label ) + std::to_string( readers ) + " readers";
+
+    double const ms = bench::measure( name.c_str(), [&]
+    {
+        std::vector<std::thread> threads;
+        for ( unsigned r = 0; r < readers; ++r )
+        {
+            threads.emplace_back( [&]
+            {
+                long sum = 0;
+                for ( std::size_t i = 0; i < reads; ++i )
+                {
+                    optional<Snapshot> const x = shared.load();
+                    sum += x ? x->field[0] : 0;
+                }
+                bench::do_not_optimize( sum );
+            } );
+        }
+        for ( auto & t : threads )
+        {
+            t.join();
+        }
+    }, 3 );
+
+    std::printf( "    %8.1f reads/us\n", readers * reads / ( ms * 1000 ) );
+
+    done = true;
+    writer.join();
+}
+
+} // anonymous namespace
+
+int main()
+{
+    unsigned const hardware = (std::max)( 1u, std::thread::hardware_concurrency() );
+
+    for ( unsigned readers = 1; readers <= 2 * hardware; readers *= 2 )
+    {
+        run< locked_optional >( "shared_timed_mutex, ", readers );
+        run< shared_optional<Snapshot> >( "shared_optional   , ", readers );
+    }
+}
+
+// g++ -std=c++14 -O2 -pthread -Doptional_CONFIG_SELECT_OPTIONAL=optional_OPTIONAL_NONSTD -I../include -o 08-shared-readers 08-shared-readers.cpp && ./08-shared-readers
@@ -0,0 +1,78 @@
+// Copyright 2026 by Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Threads repeatedly update their own optional<long> result slot, on 1, 2,
+// 4, ... up to twice the number of hardware threads: adjacent slots in a
+// std::vector< optional<long> > versus cache-line padded slots of a
+// per_thread_optional<long>.
+
+#include "nonstd/optional_padded.hpp"
+#include "bench.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using nonstd::optional;
+using nonstd::per_thread_optional;
+
+namespace {
+
+std::size_t const writes = 10 * 1000 * 1000;
+
+// the result of thread t is kept in slots[t], updated on every iteration:
+
+template< typename Slots >
+void work( Slots & slots, std::size_t t )
+{
+    for ( std::size_t i = 0; i < writes; ++i )
+    {
+        slots[t] = slots[t].value_or( 0 ) + long( i & 1 );
+        bench::do_not_optimize( &slots[t] );
+    }
+}
+
+template< typename Slots >
+void run( char const * label, unsigned threads, Slots & slots )
+{
+    std::string const name = std::string( label ) + std::to_string( threads ) + " threads";
+
+    double const ms = bench::measure( name.c_str(), [&]
+    {
+        std::vector<std::thread> pool;
+        for ( unsigned t = 0; t < threads; ++t )
+        {
+            pool.emplace_back( [&slots, t]{ work( slots, t ); } );
+        }
+        for ( auto & thread : pool )
+        {
+            thread.join();
+        }
+    }, 3 );
+
+    std::printf( "    %8.1f writes/us\n", threads * writes / ( ms * 1000 ) );
+}
+
+} // anonymous namespace
+
+int main()
+{
+    unsigned const hardware = (std::max)( 1u, std::thread::hardware_concurrency() );
+
+    for ( unsigned threads = 1; threads <= 2 * hardware; threads *= 2 )
+    {
+        std::vector< optional<long> > adjacent( threads );
+        per_thread_optional<long> padded( threads );
+
+        run( "vector< optional<long> >  , ", threads, adjacent );
+        run( "per_thread_optional<long> , ", threads, padded );
+    }
+}
+
+// g++ -std=c++11 -O2 -pthread -Doptional_CONFIG_SELECT_OPTIONAL=optional_OPTIONAL_NONSTD -I../include -o 09-padded-writes 09-padded-writes.cpp && ./09-padded-writes
@@ -0,0 +1,91 @@
+// Copyright 2026 by Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Convert 16M optional<double> between rows and columns, with one in a
+// hundred and with nine in ten engaged: to_columns() and to_rows() versus
+// loops that test each element. Reports GB/s of rows plus columns.
+
+#include "nonstd/optional_columns.hpp"
+#include "bench.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using nonstd::optional;
+using nonstd::optional_columns;
+
+namespace {
+
+std::size_t const n = 16 * 1000 * 1000;
+
+optional_columns<double> naive_columns( std::vector< optional<double> > const & rows )
+{
+    optional_columns<double> c;
+    c.values.resize( rows.size() );
+    c.validity.assign( ( rows.size() + 63 ) / 64, 0 );
+
+    for ( std::size_t i = 0; i < rows.size(); ++i )
+    {
+        if ( rows[i] )
+        {
+            c.values[i] = *rows[i];
+            c.validity[ i / 64 ] |= std::uint64_t( 1 ) << ( i % 64 );
+        }
+    }
+    return c;
+}
+
+std::vector< optional<double> > naive_rows( optional_columns<double> const & c )
+{
+    std::vector< optional<double> > rows( c.size() );
+
+    for ( std::size_t i = 0; i < c.size(); ++i )
+    {
+        if ( c.has_value( i ) )
+        {
+            rows[i] = c.values[i];
+        }
+    }
+    return rows;
+}
+
+template< typename F >
+void run( std::string const & label, F f )
+{
+    double const bytes = n * ( sizeof( optional<double> ) + sizeof( double ) + 1.0 / 8 );
+    double const ms = bench::measure( label.c_str(), f, 5 );
+
+    std::printf( "    %6.2f GB/s\n", bytes / ( ms * 1e6 ) );
+}
+
+} // anonymous namespace
+
+int main()
+{
+    for ( unsigned per_hundred : { 1u, 90u } )
+    {
+        std::mt19937 rng( 1 );
+        std::vector< optional<double> > rows( n );
+
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            if ( rng() % 100 < per_hundred ) rows[i] = double( i );
+        }
+
+        optional_columns<double> const columns = nonstd::to_columns( rows );
+        std::string const density = std::to_string( per_hundred ) + "% engaged: ";
+
+        run( density + "naive rows to columns", [&]{ bench::do_not_optimize( naive_columns( rows ).values[0] ); } );
+        run( density + "to_columns()         ", [&]{ bench::do_not_optimize( nonstd::to_columns( rows ).values[0] ); } );
+        run( density + "naive columns to rows", [&]{ bench::do_not_optimize( naive_rows( columns )[0] ); } );
+        run( density + "to_rows()            ", [&]{ bench::do_not_optimize( nonstd::to_rows( columns )[0] ); } );
+    }
+}
+
+// g++ -std=c++11 -O2 -Doptional_CONFIG_SELECT_OPTIONAL=optional_OPTIONAL_NONSTD -I../include -o 10-columns-convert 10-columns-convert.cpp && ./10-columns-convert
@@ -0,0 +1,85 @@
+// Copyright 2026 by Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Read engaged optional<std::string> and optional<std::vector<int>> values
+// with a fallback: value_or(), which copies the value, versus value_or_ref(),
+// which does not; and take the value of a temporary optional: value_or() on
+// an lvalue, which copies, versus on an rvalue, which moves (except with
+// clang, where it copies as well).
+
+#include "nonstd/optional.hpp"
+#include "bench.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using nonstd::optional;
+
+namespace {
+
+std::size_t const n = 1000 * 1000;
+
+template< typename T >
+void run( char const * type, T const & value, T const & fallback )
+{
+    optional<T> const o( value );
+    std::string const label( type );
+
+    bench::measure( ( label + ": value_or()           " ).c_str(), [&]
+    {
+        std::size_t size = 0;
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            bench::do_not_optimize( o );
+            size += o.value_or( fallback ).size();
+        }
+        bench::do_not_optimize( size );
+    } );
+
+    bench::measure( ( label + ": value_or_ref()       " ).c_str(), [&]
+    {
+        std::size_t size = 0;
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            bench::do_not_optimize( o );
+            size += o.value_or_ref( fallback ).size();
+        }
+        bench::do_not_optimize( size );
+    } );
+
+    std::vector< optional<T> > copies( n / 10, o );
+    std::vector< optional<T> > moves( n / 10, o );
+
+    bench::measure( ( label + ": value_or() & (copy)  " ).c_str(), [&]
+    {
+        for ( auto & x : copies )
+        {
+            T t = x.value_or( fallback );
+            bench::do_not_optimize( t );
+        }
+    }, 1 );
+
+    bench::measure( ( label + ": value_or() && (move) " ).c_str(), [&]
+    {
+        for ( auto & x : moves )
+        {
+            T t = std::move( x ).value_or( fallback );
+            bench::do_not_optimize( t );
+        }
+    }, 1 );
+}
+
+} // anonymous namespace
+
+int main()
+{
+    run( "optional<std::string>     ", std::string( 100, 'v' ), std::string( "fallback" ) );
+    run( "optional<std::vector<int>>", std::vector<int>( 100, 7 ), std::vector<int>() );
+}
+
+// g++ -std=c++11 -O2 -Doptional_CONFIG_SELECT_OPTIONAL=optional_OPTIONAL_NONSTD -I../include -o 11-value-or-copies 11-value-or-copies.cpp && ./11-value-or-copies
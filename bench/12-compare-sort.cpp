@@ -0,0 +1,89 @@
+// Copyright 2026 by Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Sort vectors of optional<int>, optional<double> and optional<std::string>,
+// one in ten empty, with std::sort and operator<, and compare vectors of
+// optional<std::string> lexicographically. Built as C++17 this uses the
+// relational operator set, built as C++20 operator<=> and operator==.
+
+#include "nonstd/optional.hpp"
+#include "bench.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using nonstd::optional;
+
+namespace {
+
+template< typename T, typename Generate >
+std::vector< optional<T> > make_input( std::size_t n, Generate generate )
+{
+    std::mt19937_64 rng( 1 );
+    std::vector< optional<T> > v( n );
+
+    for ( auto & x : v )
+    {
+        if ( rng() % 10 ) x = generate( rng );
+    }
+    return v;
+}
+
+template< typename T >
+void sort( char const * type, std::vector< optional<T> > const & input )
+{
+    std::vector< optional<T> > v;
+
+    std::string const label = std::string( type ) + ": std::sort";
+
+    bench::measure( label.c_str(), [&]{ v = input; std::sort( v.begin(), v.end() ); bench::do_not_optimize( v[0] ); }, 3 );
+}
+
+// rows that share a long common prefix, so that operator< on the vectors
+// visits many equal elements before the first difference:
+
+void compare_rows( std::size_t n, std::size_t length )
+{
+    std::vector< optional<std::string> > const prefix = make_input<std::string>( length, []( std::mt19937_64 & r ) { return std::string( "key-" ) + std::to_string( r() % 1000 ); } );
+    std::vector< std::vector< optional<std::string> > > rows( n, prefix );
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        rows[i].back() = std::to_string( i % 97 );
+    }
+
+    bench::measure( "vector< optional<string> >: operator<", [&]
+    {
+        std::size_t less = 0;
+        for ( std::size_t i = 1; i < n; ++i )
+        {
+            less += rows[i - 1] < rows[i];
+        }
+        bench::do_not_optimize( less );
+    } );
+}
+
+} // anonymous namespace
+
+int main()
+{
+    std::size_t const n = 1000 * 1000;
+
+    std::printf( "%s\n", optional_HAVE( THREE_WAY_COMPARISON ) ? "operator<=> and operator==" : "relational operator set" );
+
+    sort( "optional<int>            ", make_input<int        >( n, []( std::mt19937_64 & r ) { return static_cast<int>( r() % 1000000 ); } ) );
+    sort( "optional<double>         ", make_input<double     >( n, []( std::mt19937_64 & r ) { return std::uniform_real_distribution<double>( -1e9, 1e9 )( r ); } ) );
+    sort( "optional<std::string>    ", make_input<std::string>( n, []( std::mt19937_64 & r ) { return std::string( "key-" ) + std::to_string( r() ); } ) );
+
+    compare_rows( 10000, 1000 );
+}
+
+// g++ -std=c++17 -O2 -Doptional_CONFIG_SELECT_OPTIONAL=optional_OPTIONAL_NONSTD -I../include -o 12-compare-sort-cpp17 12-compare-sort.cpp && ./12-compare-sort-cpp17
+// g++ -std=c++20 -O2 -Doptional_CONFIG_SELECT_OPTIONAL=optional_OPTIONAL_NONSTD -I../include -o 12-compare-sort-cpp20 12-compare-sort.cpp && ./12-compare-sort-cpp20
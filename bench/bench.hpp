@@ -0,0 +1,59 @@
+// Copyright 2026 by Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Minimal timing support for the optional-lite benchmarks.
+
+#pragma once
+
+#ifndef BENCH_OPTIONAL_LITE_H_INCLUDED
+#define BENCH_OPTIONAL_LITE_H_INCLUDED
+
+#include <chrono>
+#include <cstdio>
+
+namespace bench {
+
+// prevent the optimizer from discarding a computed value:
+
+template< typename T >
+inline void do_not_optimize( T const & value )
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile( "" : : "r,m"( value ) : "memory" );
+#else
+    static volatile char sink;
+    sink = *reinterpret_cast<char const volatile *>( &value );
+#endif
+}
+
+// run f() repeatedly, report and return the best time in milliseconds:
+
+template< typename F >
+inline double measure( char const * label, F f, int repeat = 5 )
+{
+    double best = 1e300;
+
+    for ( int i = 0; i < repeat; ++i )
+    {
+        auto const start = std::chrono::steady_clock::now();
+        f();
+        auto const stop  = std::chrono::steady_clock::now();
+
+        double const ms = std::chrono::duration<double, std::milli>( stop - start ).count();
+
+        best = ms < best ? ms : best;
+    }
+
+    std::printf( "%-48s %10.3f ms\n", label, best );
+    return best;
+}
+
+} // namespace bench
+
+#endif // BENCH_OPTIONAL_LITE_H_INCLUDED
+
+// end of file
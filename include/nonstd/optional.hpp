@@ -26,6 +26,11 @@
 #define optional_OPTIONAL_NONSTD   1
 #define optional_OPTIONAL_STD      2
 
+#define optional_ON_BAD_ACCESS_ASSERT  0
+#define optional_ON_BAD_ACCESS_THROW   1
+#define optional_ON_BAD_ACCESS_TRAP    2
+#define optional_ON_BAD_ACCESS_HOOK    3
+
 // tweak header support:
 
 #ifdef __has_include
@@ -50,6 +55,18 @@
 #define optional_CONFIG_NO_EXTENSIONS  0
 #endif
 
+// Control instrumentation of constructions, assignments, resets, bad accesses and destructions (C++11):
+
+#ifndef optional_CONFIG_INSTRUMENT
+# define optional_CONFIG_INSTRUMENT  0
+#endif
+
+// Control registration of the layout of every instantiated optional<T>:
+
+#ifndef optional_CONFIG_LAYOUT_AUDIT
+# define optional_CONFIG_LAYOUT_AUDIT  0
+#endif
+
 // Control marking class bad_optional_access and several methods with [[nodiscard]]]:
 
 #if !defined(optional_CONFIG_NO_NODISCARD)
@@ -71,6 +88,22 @@
 # endif
 #endif
 
+// Control the base class of bad_optional_access: std::exception (no allocation) or std::logic_error (compatible):
+
+#ifndef optional_CONFIG_BAD_ACCESS_LOGIC_ERROR
+# define optional_CONFIG_BAD_ACCESS_LOGIC_ERROR  0
+#endif
+
+// Control the response of value() to an empty optional (assert, throw, trap or call user hook):
+
+#ifndef optional_CONFIG_ON_BAD_ACCESS
+# if optional_CONFIG_NO_EXCEPTIONS
+#  define optional_CONFIG_ON_BAD_ACCESS  optional_ON_BAD_ACCESS_ASSERT
+# else
+#  define optional_CONFIG_ON_BAD_ACCESS  optional_ON_BAD_ACCESS_THROW
+# endif
+#endif
+
 // C++ language version detection (C++23 is speculative):
 // Note: VC14.0/1900 (VS2015) lacks too much from C++14.
 
@@ -228,6 +261,10 @@ namespace nonstd {
 #include <cassert>
 #include <utility>
 
+#if ! optional_CPP11_OR_GREATER
+# include <algorithm>  // std::swap
+#endif
+
 // optional-lite alignment configuration:
 
 #ifndef  optional_CONFIG_MAX_ALIGN_HACK
@@ -358,6 +395,20 @@ namespace nonstd {
 
 #define optional_HAVE_NODISCARD         optional_CPP17_000
 
+// Presence of C++20 language features:
+
+#if optional_CPP20_OR_GREATER && defined( __cpp_impl_coroutine )
+# define optional_HAVE_COROUTINES       1
+#else
+# define optional_HAVE_COROUTINES       0
+#endif
+
+#if optional_CPP20_OR_GREATER && defined( __cpp_impl_three_way_comparison ) && defined( __cpp_concepts )
+# define optional_HAVE_THREE_WAY_COMPARISON  1
+#else
+# define optional_HAVE_THREE_WAY_COMPARISON  0
+#endif
+
 // Presence of C++ library features:
 
 #define optional_HAVE_CONDITIONAL       optional_CPP11_120
@@ -373,6 +424,10 @@ namespace nonstd {
 #define optional_HAVE_IS_NOTHROW_MOVE_CONSTRUCTIBLE     optional_CPP11_110_C350
 #define optional_HAVE_IS_TRIVIALLY_COPY_CONSTRUCTIBLE   optional_CPP11_110_C350_G500
 #define optional_HAVE_IS_TRIVIALLY_MOVE_CONSTRUCTIBLE   optional_CPP11_110_C350_G500
+#define optional_HAVE_IS_TRIVIALLY_COPYABLE             optional_CPP11_110_C350_G500
+#define optional_HAVE_IS_TRIVIALLY_COPY_ASSIGNABLE      optional_CPP11_110_C350_G500
+#define optional_HAVE_IS_TRIVIALLY_MOVE_ASSIGNABLE      optional_CPP11_110_C350_G500
+#define optional_HAVE_IS_TRIVIALLY_DESTRUCTIBLE         optional_CPP11_110_C350
 
 // C++ feature usage:
 
@@ -427,12 +482,56 @@ namespace nonstd {
 # define optional_static_assert(expr, text)  /*static_assert(expr, text);*/
 #endif
 
+// Keep the failure path of value() out of line and out of the hot code:
+
+#if optional_COMPILER_GNUC_VERSION || optional_COMPILER_CLANG_VERSION
+# define optional_cold_noreturn  __attribute__(( noinline, cold, noreturn ))
+#elif optional_COMPILER_MSVC_VER
+# define optional_cold_noreturn  __declspec( noinline ) __declspec( noreturn )
+#else
+# define optional_cold_noreturn  /*noinline, cold, noreturn*/
+#endif
+
+// Instrumentation requires C++11 (thread_local, atomic):
+
+#define optional_USES_INSTRUMENT  ( optional_CONFIG_INSTRUMENT && optional_CPP11_OR_GREATER )
+
+#if optional_USES_INSTRUMENT
+# define optional_INSTRUMENT( event )  ::nonstd::optional_lite::instrument::detail::record<T>( ::nonstd::optional_lite::instrument::event )
+# define optional_constexpr_ctor  /*constexpr: C++11 requires empty body*/
+#else
+# define optional_INSTRUMENT( event )  /*instrument*/
+# define optional_constexpr_ctor  optional_constexpr
+#endif
+
+#define optional_USES_LAYOUT_AUDIT  optional_CONFIG_LAYOUT_AUDIT
+
+// Instrumentation and layout audit require user-provided special members:
+
+#define optional_USES_TRIVIAL_MEMBERS  ( !optional_USES_INSTRUMENT && !optional_USES_LAYOUT_AUDIT )
+
+#if optional_USES_LAYOUT_AUDIT
+# define optional_LAYOUT_AUDIT()  static_cast<void>( &::nonstd::optional_lite::layout::detail::registrar<T>::registered )
+#else
+# define optional_LAYOUT_AUDIT()  /*layout audit*/
+#endif
+
 // additional includes:
 
 #if optional_CONFIG_NO_EXCEPTIONS
 // already included: <cassert>
-#else
+#elif optional_CONFIG_BAD_ACCESS_LOGIC_ERROR
 # include <stdexcept>
+#else
+# include <exception>
+#endif
+
+#if optional_CONFIG_ON_BAD_ACCESS == optional_ON_BAD_ACCESS_THROW && optional_CONFIG_NO_EXCEPTIONS
+# error optional-lite: optional_CONFIG_ON_BAD_ACCESS=optional_ON_BAD_ACCESS_THROW requires exceptions
+#endif
+
+#if optional_CONFIG_ON_BAD_ACCESS == optional_ON_BAD_ACCESS_TRAP || optional_CONFIG_ON_BAD_ACCESS == optional_ON_BAD_ACCESS_HOOK
+# include <cstdlib>
 #endif
 
 #if optional_CPP11_OR_GREATER
@@ -443,12 +542,31 @@ namespace nonstd {
 # include <initializer_list>
 #endif
 
+#if optional_HAVE( THREE_WAY_COMPARISON )
+# include <compare>
+# include <concepts>
+#endif
+
 #if optional_HAVE( TYPE_TRAITS )
 # include <type_traits>
 #elif optional_HAVE( TR1_TYPE_TRAITS )
 # include <tr1/type_traits>
 #endif
 
+#if optional_USES_INSTRUMENT
+# include <atomic>
+# include <cstdint>
+# include <mutex>
+#endif
+
+#if optional_USES_INSTRUMENT || optional_USES_LAYOUT_AUDIT
+# include <algorithm>
+# include <ostream>
+# include <sstream>
+# include <string>
+# include <vector>
+#endif
+
 // Method enabling
 
 #if optional_CPP11_OR_GREATER
@@ -518,16 +636,42 @@ typedef bool_constant< false > false_type;
     template< class T > struct is_nothrow_move_constructible : std11::true_type{};
 #endif
 
+// Note: absence of a triviality trait is taken as 'not trivial' to select the general code path:
+
 #if optional_HAVE( IS_TRIVIALLY_COPY_CONSTRUCTIBLE )
     using std::is_trivially_copy_constructible;
 #else
-    template< class T > struct is_trivially_copy_constructible : std11::true_type{};
+    template< class T > struct is_trivially_copy_constructible : std11::false_type{};
 #endif
 
 #if optional_HAVE( IS_TRIVIALLY_MOVE_CONSTRUCTIBLE )
     using std::is_trivially_move_constructible;
 #else
-    template< class T > struct is_trivially_move_constructible : std11::true_type{};
+    template< class T > struct is_trivially_move_constructible : std11::false_type{};
+#endif
+
+#if optional_HAVE( IS_TRIVIALLY_COPY_ASSIGNABLE )
+    using std::is_trivially_copy_assignable;
+#else
+    template< class T > struct is_trivially_copy_assignable : std11::false_type{};
+#endif
+
+#if optional_HAVE( IS_TRIVIALLY_MOVE_ASSIGNABLE )
+    using std::is_trivially_move_assignable;
+#else
+    template< class T > struct is_trivially_move_assignable : std11::false_type{};
+#endif
+
+#if optional_HAVE( IS_TRIVIALLY_DESTRUCTIBLE )
+    using std::is_trivially_destructible;
+#else
+    template< class T > struct is_trivially_destructible : std11::false_type{};
+#endif
+
+#if optional_HAVE( IS_TRIVIALLY_COPYABLE )
+    using std::is_trivially_copyable;
+#else
+    template< class T > struct is_trivially_copyable : std11::false_type{};
 #endif
 
 } // namespace std11
@@ -608,206 +752,680 @@ struct remove_cvref
 template< typename T >
 class optional;
 
+#if optional_USES_INSTRUMENT || optional_USES_LAYOUT_AUDIT
+
 namespace detail {
 
-// C++11 emulation:
+template< typename T >
+char const * type_signature()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    return __FUNCSIG__;
+#else
+    return __PRETTY_FUNCTION__;
+#endif
+}
 
-struct nulltype{};
+// extract T from type_signature<T>()'s pretty function name:
 
-template< typename Head, typename Tail >
-struct typelist
+inline std::string type_name( std::string const & sig )
 {
-    typedef Head head;
-    typedef Tail tail;
-};
-
-#if optional_CONFIG_MAX_ALIGN_HACK
+    std::string::size_type pos = sig.find( "T = " );
 
-// Max align, use most restricted type for alignment:
+    if ( pos != std::string::npos )
+    {
+        pos += 4;
+        return sig.substr( pos, sig.find_first_of( ";]", pos ) - pos );
+    }
 
-#define optional_UNIQUE(  name )       optional_UNIQUE2( name, __LINE__ )
-#define optional_UNIQUE2( name, line ) optional_UNIQUE3( name, line )
-#define optional_UNIQUE3( name, line ) name ## line
+    pos = sig.find( "type_signature<" );
 
-#define optional_ALIGN_TYPE( type ) \
-    type optional_UNIQUE( _t ); struct_t< type > optional_UNIQUE( _st )
+    if ( pos != std::string::npos )
+    {
+        pos += 15;
+        return sig.substr( pos, sig.rfind( ">(" ) - pos );
+    }
+    return sig;
+}
 
-template< typename T >
-struct struct_t { T _; };
+} // namespace detail
 
-union max_align_t
-{
-    optional_ALIGN_TYPE( char );
-    optional_ALIGN_TYPE( short int );
-    optional_ALIGN_TYPE( int );
-    optional_ALIGN_TYPE( long int  );
-    optional_ALIGN_TYPE( float  );
-    optional_ALIGN_TYPE( double );
-    optional_ALIGN_TYPE( long double );
-    optional_ALIGN_TYPE( char * );
-    optional_ALIGN_TYPE( short int * );
-    optional_ALIGN_TYPE( int *  );
-    optional_ALIGN_TYPE( long int * );
-    optional_ALIGN_TYPE( float * );
-    optional_ALIGN_TYPE( double * );
-    optional_ALIGN_TYPE( long double * );
-    optional_ALIGN_TYPE( void * );
+#endif // optional_USES_INSTRUMENT || optional_USES_LAYOUT_AUDIT
 
-#ifdef HAVE_LONG_LONG
-    optional_ALIGN_TYPE( long long );
-#endif
+#if optional_USES_INSTRUMENT
 
-    struct Unknown;
+/// instrumentation: per payload type event counters
+///
+/// Each thread counts into its own counters for each payload type; these are
+/// summed on demand. Counters of a thread that ends are retained.
 
-    Unknown ( * optional_UNIQUE(_) )( Unknown );
-    Unknown * Unknown::* optional_UNIQUE(_);
-    Unknown ( Unknown::* optional_UNIQUE(_) )( Unknown );
+namespace instrument {
 
-    struct_t< Unknown ( * )( Unknown)         > optional_UNIQUE(_);
-    struct_t< Unknown * Unknown::*            > optional_UNIQUE(_);
-    struct_t< Unknown ( Unknown::* )(Unknown) > optional_UNIQUE(_);
+enum event
+{
+    default_construction,
+    value_construction,
+    copy_construction,
+    move_construction,
+    copy_assignment,
+    move_assignment,
+    value_assignment,
+    emplace_call,
+    reset_call,
+    bad_access,
+    destruction,
+    engaged_destruction,
+    event_count
 };
 
-#undef optional_UNIQUE
-#undef optional_UNIQUE2
-#undef optional_UNIQUE3
-
-#undef optional_ALIGN_TYPE
-
-#elif defined( optional_CONFIG_ALIGN_AS ) // optional_CONFIG_MAX_ALIGN_HACK
+inline char const * event_name( event e )
+{
+    static char const * const names[] =
+    {
+        "default_construction",
+        "value_construction",
+        "copy_construction",
+        "move_construction",
+        "copy_assignment",
+        "move_assignment",
+        "value_assignment",
+        "emplace",
+        "reset",
+        "bad_access",
+        "destruction",
+        "engaged_destruction",
+    };
+    return names[ e ];
+}
 
-// Use user-specified type for alignment:
+/// aggregated counts for one payload type
 
-#define optional_ALIGN_AS( unused ) \
-    optional_CONFIG_ALIGN_AS
+struct stats
+{
+    std::string   type;
+    std::uint64_t count[ event_count ];
 
-#else // optional_CONFIG_MAX_ALIGN_HACK
+    double engaged_at_destruction() const
+    {
+        return count[ destruction ] == 0 ? 0.0
+            : static_cast<double>( count[ engaged_destruction ] ) / static_cast<double>( count[ destruction ] );
+    }
+};
 
-// Determine POD type to use for alignment:
+enum format { text, json };
 
-#define optional_ALIGN_AS( to_align ) \
-    typename type_of_size< alignment_types, alignment_of< to_align >::value >::type
+namespace detail {
 
-template< typename T >
-struct alignment_of;
+struct type_record;
 
-template< typename T >
-struct alignment_of_hack
+struct thread_counters
 {
-    char c;
-    T t;
-    alignment_of_hack();
-};
+    std::atomic<std::uint64_t> count[ event_count ];
+    type_record * record;
 
-template< size_t A, size_t S >
-struct alignment_logic
-{
-    enum { value = A < S ? A : S };
+    explicit thread_counters( type_record * r );
+    ~thread_counters();
 };
 
-template< typename T >
-struct alignment_of
+struct type_record
 {
-    enum { value = alignment_logic<
-        sizeof( alignment_of_hack<T> ) - sizeof(T), sizeof(T) >::value };
+    char const * signature;
+    std::mutex mutex;
+    std::vector< thread_counters * > live;
+    std::uint64_t retired[ event_count ];
+
+    explicit type_record( char const * sig )
+    : signature( sig )
+    , retired()
+    {}
 };
 
-template< typename List, size_t N >
-struct type_of_size
-{
-    typedef typename std11::conditional<
-        N == sizeof( typename List::head ),
-            typename List::head,
-            typename type_of_size<typename List::tail, N >::type >::type type;
-};
+// Records are never destroyed, so that threads may still end after main():
 
-template< size_t N >
-struct type_of_size< nulltype, N >
+struct registry
 {
-    typedef optional_CONFIG_ALIGN_AS_FALLBACK type;
-};
+    std::mutex mutex;
+    std::vector< type_record * > types;
 
-template< typename T>
-struct struct_t { T _; };
-
-#define optional_ALIGN_TYPE( type ) \
-    typelist< type , typelist< struct_t< type >
+    static registry & instance()
+    {
+        static registry * const r = new registry();
+        return *r;
+    }
 
-struct Unknown;
+    type_record * add( char const * signature )
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        types.push_back( new type_record( signature ) );
+        return types.back();
+    }
+};
 
-typedef
-    optional_ALIGN_TYPE( char ),
-    optional_ALIGN_TYPE( short ),
-    optional_ALIGN_TYPE( int ),
-    optional_ALIGN_TYPE( long ),
-    optional_ALIGN_TYPE( float ),
-    optional_ALIGN_TYPE( double ),
-    optional_ALIGN_TYPE( long double ),
+inline thread_counters::thread_counters( type_record * r )
+: record( r )
+{
+    for ( auto & c : count )
+    {
+        c.store( 0, std::memory_order_relaxed );
+    }
 
-    optional_ALIGN_TYPE( char *),
-    optional_ALIGN_TYPE( short * ),
-    optional_ALIGN_TYPE( int * ),
-    optional_ALIGN_TYPE( long * ),
-    optional_ALIGN_TYPE( float * ),
-    optional_ALIGN_TYPE( double * ),
-    optional_ALIGN_TYPE( long double * ),
+    std::lock_guard< std::mutex > lock( record->mutex );
+    record->live.push_back( this );
+}
 
-    optional_ALIGN_TYPE( Unknown ( * )( Unknown ) ),
-    optional_ALIGN_TYPE( Unknown * Unknown::*     ),
-    optional_ALIGN_TYPE( Unknown ( Unknown::* )( Unknown ) ),
+inline thread_counters::~thread_counters()
+{
+    std::lock_guard< std::mutex > lock( record->mutex );
 
-    nulltype
-    > > > > > > >    > > > > > > >
-    > > > > > > >    > > > > > > >
-    > > > > > >
-    alignment_types;
+    for ( int e = 0; e < event_count; ++e )
+    {
+        record->retired[e] += count[e].load( std::memory_order_relaxed );
+    }
 
-#undef optional_ALIGN_TYPE
+    for ( std::size_t i = 0; i < record->live.size(); ++i )
+    {
+        if ( record->live[i] == this )
+        {
+            record->live[i] = record->live.back();
+            record->live.pop_back();
+            break;
+        }
+    }
+}
 
-#endif // optional_CONFIG_MAX_ALIGN_HACK
+template< typename T >
+type_record & record_of()
+{
+    static type_record * const r = registry::instance().add( optional_lite::detail::type_signature<T>() );
+    return *r;
+}
 
-/// C++03 constructed union to hold value.
+// Only the owning thread writes its counters, so a relaxed load and store suffice:
 
 template< typename T >
-union storage_t
+void record( event e )
 {
-//private:
-//    template< typename > friend class optional;
-
-    typedef T value_type;
+    thread_local thread_counters local( &record_of<T>() );
 
-    storage_t() optional_is_default
+    std::atomic<std::uint64_t> & c = local.count[ e ];
+    c.store( c.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+}
 
-    explicit storage_t( value_type const & v )
+inline std::string json_escape( std::string const & s )
+{
+    std::string result;
+    for ( char c : s )
     {
-        construct_value( v );
+        if ( c == '"' || c == '\\' ) result += '\\';
+        result += c;
     }
+    return result;
+}
 
-    void construct_value( value_type const & v )
-    {
-        ::new( value_ptr() ) value_type( v );
-    }
+} // namespace detail
 
-#if optional_CPP11_OR_GREATER
+/// sum of the counts of all threads, per payload type
 
-    explicit storage_t( value_type && v )
-    {
-        construct_value( std::move( v ) );
-    }
+inline std::vector< stats > snapshot()
+{
+    detail::registry & reg = detail::registry::instance();
+    std::lock_guard< std::mutex > lock( reg.mutex );
 
-    void construct_value( value_type && v )
-    {
-        ::new( const_cast<void *>(static_cast<const volatile void *>(value_ptr())) ) value_type( std::move( v ) );
-    }
+    std::vector< stats > result;
 
-    template< class... Args >
-    storage_t( nonstd_lite_in_place_t(T), Args&&... args )
+    for ( detail::type_record * r : reg.types )
     {
-        emplace( std::forward<Args>(args)... );
-    }
+        std::lock_guard< std::mutex > lock_type( r->mutex );
 
-    template< class... Args >
-    void emplace( Args&&... args )
+        stats s;
+        s.type = optional_lite::detail::type_name( r->signature );
+
+        for ( int e = 0; e < event_count; ++e )
+        {
+            s.count[e] = r->retired[e];
+
+            for ( detail::thread_counters const * t : r->live )
+            {
+                s.count[e] += t->count[e].load( std::memory_order_relaxed );
+            }
+        }
+        result.push_back( s );
+    }
+    return result;
+}
+
+/// set all counts to zero; counts from concurrently running threads may get lost
+
+inline void reset()
+{
+    detail::registry & reg = detail::registry::instance();
+    std::lock_guard< std::mutex > lock( reg.mutex );
+
+    for ( detail::type_record * r : reg.types )
+    {
+        std::lock_guard< std::mutex > lock_type( r->mutex );
+
+        for ( int e = 0; e < event_count; ++e )
+        {
+            r->retired[e] = 0;
+
+            for ( detail::thread_counters * t : r->live )
+            {
+                t->count[e].store( 0, std::memory_order_relaxed );
+            }
+        }
+    }
+}
+
+/// write the counts of all payload types as text or JSON
+
+inline void dump( std::ostream & os, format f = text )
+{
+    std::vector< stats > const all = snapshot();
+
+    if ( f == json )
+    {
+        os << "[";
+        for ( std::size_t i = 0; i < all.size(); ++i )
+        {
+            os << ( i ? ",\n " : "\n " ) << "{\"type\": \"" << detail::json_escape( all[i].type ) << "\"";
+            for ( int e = 0; e < event_count; ++e )
+            {
+                os << ", \"" << event_name( static_cast<event>( e ) ) << "\": " << all[i].count[e];
+            }
+            os << ", \"engaged_at_destruction\": " << all[i].engaged_at_destruction() << "}";
+        }
+        os << "\n]\n";
+    }
+    else
+    {
+        for ( stats const & s : all )
+        {
+            os << "optional<" << s.type << ">:\n";
+            for ( int e = 0; e < event_count; ++e )
+            {
+                os << "  " << event_name( static_cast<event>( e ) ) << ": " << s.count[e] << "\n";
+            }
+            os << "  engaged_at_destruction: " << s.engaged_at_destruction() << "\n";
+        }
+    }
+}
+
+inline std::string report( format f = text )
+{
+    std::ostringstream os;
+    dump( os, f );
+    return os.str();
+}
+
+} // namespace instrument
+
+#endif // optional_USES_INSTRUMENT
+
+#if optional_USES_LAYOUT_AUDIT
+
+/// layout audit: size, alignment and padding of every instantiated optional<T>
+///
+/// An optional<T> registers its layout during static initialization when its
+/// destructor is instantiated.
+
+namespace layout {
+
+struct entry
+{
+    std::string type;
+    std::size_t size;       // sizeof( optional<T> )
+    std::size_t align;      // alignof( optional<T> )
+    std::size_t payload;    // sizeof( T )
+    std::size_t waste;      // size - payload - sizeof( bool )
+};
+
+namespace detail {
+
+template< typename T >
+struct align_of_hack
+{
+    char c;
+    T t;
+    align_of_hack();
+};
+
+template< typename T >
+struct align_of
+{
+#if optional_CPP11_OR_GREATER
+    enum { value = std::alignment_of<T>::value };
+#else
+    enum { value = sizeof( align_of_hack<T> ) - sizeof(T) };
+#endif
+};
+
+inline std::vector< entry > & registry()
+{
+    static std::vector< entry > * const r = new std::vector< entry >();
+    return *r;
+}
+
+template< typename T >
+struct registrar
+{
+    static bool const registered;
+
+    static bool add()
+    {
+        entry e;
+        e.type    = optional_lite::detail::type_name( optional_lite::detail::type_signature<T>() );
+        e.size    = sizeof( optional<T> );
+        e.align   = align_of< optional<T> >::value;
+        e.payload = sizeof( T );
+        e.waste   = e.size - e.payload - sizeof( bool );
+
+        registry().push_back( e );
+        return true;
+    }
+};
+
+template< typename T >
+bool const registrar<T>::registered = registrar<T>::add();
+
+inline bool more_waste( entry const & a, entry const & b )
+{
+    return a.waste != b.waste ? a.waste > b.waste : a.type < b.type;
+}
+
+} // namespace detail
+
+/// layout of all registered optional<T>, most wasted bytes first
+
+inline std::vector< entry > entries()
+{
+    std::vector< entry > result( detail::registry() );
+    std::sort( result.begin(), result.end(), detail::more_waste );
+    return result;
+}
+
+/// write the layout of all registered optional<T>, most wasted bytes first
+
+inline void dump( std::ostream & os )
+{
+    std::vector< entry > const all = entries();
+
+    os << "size\talign\tpayload\twaste\ttype\n";
+
+    for ( std::size_t i = 0; i < all.size(); ++i )
+    {
+        os << all[i].size << "\t" << all[i].align << "\t" << all[i].payload << "\t" << all[i].waste << "\toptional<" << all[i].type << ">\n";
+    }
+}
+
+inline std::string report()
+{
+    std::ostringstream os;
+    dump( os );
+    return os.str();
+}
+
+} // namespace layout
+
+#endif // optional_USES_LAYOUT_AUDIT
+
+#if optional_CPP11_OR_GREATER && !optional_CONFIG_NO_EXTENSIONS
+
+/// select in-place construction from the result of a call,
+/// see optional( in_place_invoke, f, args... ):
+
+struct in_place_invoke_t
+{
+    explicit in_place_invoke_t() = default;
+};
+
+#if optional_HAVE( CONSTEXPR_11 )
+constexpr in_place_invoke_t in_place_invoke{};
+#else
+const in_place_invoke_t in_place_invoke{};
+#endif
+
+#endif
+
+namespace detail {
+
+// C++11 emulation:
+
+struct nulltype{};
+
+template< typename Head, typename Tail >
+struct typelist
+{
+    typedef Head head;
+    typedef Tail tail;
+};
+
+#if optional_CONFIG_MAX_ALIGN_HACK
+
+// Max align, use most restricted type for alignment:
+
+#define optional_UNIQUE(  name )       optional_UNIQUE2( name, __LINE__ )
+#define optional_UNIQUE2( name, line ) optional_UNIQUE3( name, line )
+#define optional_UNIQUE3( name, line ) name ## line
+
+#define optional_ALIGN_TYPE( type ) \
+    type optional_UNIQUE( _t ); struct_t< type > optional_UNIQUE( _st )
+
+template< typename T >
+struct struct_t { T _; };
+
+union max_align_t
+{
+    optional_ALIGN_TYPE( char );
+    optional_ALIGN_TYPE( short int );
+    optional_ALIGN_TYPE( int );
+    optional_ALIGN_TYPE( long int  );
+    optional_ALIGN_TYPE( float  );
+    optional_ALIGN_TYPE( double );
+    optional_ALIGN_TYPE( long double );
+    optional_ALIGN_TYPE( char * );
+    optional_ALIGN_TYPE( short int * );
+    optional_ALIGN_TYPE( int *  );
+    optional_ALIGN_TYPE( long int * );
+    optional_ALIGN_TYPE( float * );
+    optional_ALIGN_TYPE( double * );
+    optional_ALIGN_TYPE( long double * );
+    optional_ALIGN_TYPE( void * );
+
+#ifdef HAVE_LONG_LONG
+    optional_ALIGN_TYPE( long long );
+#endif
+
+    struct Unknown;
+
+    Unknown ( * optional_UNIQUE(_) )( Unknown );
+    Unknown * Unknown::* optional_UNIQUE(_);
+    Unknown ( Unknown::* optional_UNIQUE(_) )( Unknown );
+
+    struct_t< Unknown ( * )( Unknown)         > optional_UNIQUE(_);
+    struct_t< Unknown * Unknown::*            > optional_UNIQUE(_);
+    struct_t< Unknown ( Unknown::* )(Unknown) > optional_UNIQUE(_);
+};
+
+#undef optional_UNIQUE
+#undef optional_UNIQUE2
+#undef optional_UNIQUE3
+
+#undef optional_ALIGN_TYPE
+
+#elif defined( optional_CONFIG_ALIGN_AS ) // optional_CONFIG_MAX_ALIGN_HACK
+
+// Use user-specified type for alignment:
+
+#define optional_ALIGN_AS( unused ) \
+    optional_CONFIG_ALIGN_AS
+
+#else // optional_CONFIG_MAX_ALIGN_HACK
+
+// Determine POD type to use for alignment:
+
+#define optional_ALIGN_AS( to_align ) \
+    typename type_of_size< alignment_types, alignment_of< to_align >::value >::type
+
+template< typename T >
+struct alignment_of;
+
+template< typename T >
+struct alignment_of_hack
+{
+    char c;
+    T t;
+    alignment_of_hack();
+};
+
+template< size_t A, size_t S >
+struct alignment_logic
+{
+    enum { value = A < S ? A : S };
+};
+
+template< typename T >
+struct alignment_of
+{
+    enum { value = alignment_logic<
+        sizeof( alignment_of_hack<T> ) - sizeof(T), sizeof(T) >::value };
+};
+
+template< typename List, size_t N >
+struct type_of_size
+{
+    typedef typename std11::conditional<
+        N == sizeof( typename List::head ),
+            typename List::head,
+            typename type_of_size<typename List::tail, N >::type >::type type;
+};
+
+template< size_t N >
+struct type_of_size< nulltype, N >
+{
+    typedef optional_CONFIG_ALIGN_AS_FALLBACK type;
+};
+
+template< typename T>
+struct struct_t { T _; };
+
+#define optional_ALIGN_TYPE( type ) \
+    typelist< type , typelist< struct_t< type >
+
+struct Unknown;
+
+typedef
+    optional_ALIGN_TYPE( char ),
+    optional_ALIGN_TYPE( short ),
+    optional_ALIGN_TYPE( int ),
+    optional_ALIGN_TYPE( long ),
+    optional_ALIGN_TYPE( float ),
+    optional_ALIGN_TYPE( double ),
+    optional_ALIGN_TYPE( long double ),
+
+    optional_ALIGN_TYPE( char *),
+    optional_ALIGN_TYPE( short * ),
+    optional_ALIGN_TYPE( int * ),
+    optional_ALIGN_TYPE( long * ),
+    optional_ALIGN_TYPE( float * ),
+    optional_ALIGN_TYPE( double * ),
+    optional_ALIGN_TYPE( long double * ),
+
+    optional_ALIGN_TYPE( Unknown ( * )( Unknown ) ),
+    optional_ALIGN_TYPE( Unknown * Unknown::*     ),
+    optional_ALIGN_TYPE( Unknown ( Unknown::* )( Unknown ) ),
+
+    nulltype
+    > > > > > > >    > > > > > > >
+    > > > > > > >    > > > > > > >
+    > > > > > >
+    alignment_types;
+
+#undef optional_ALIGN_TYPE
+
+#endif // optional_CONFIG_MAX_ALIGN_HACK
+
+#if optional_CPP11_OR_GREATER
+
+/// C++11 union with the value as a member, so that a trivial copy of the
+/// storage copies a T and not the bytes of an aligned_storage object.
+
+template< typename T, bool = std11::is_trivially_destructible<T>::value >
+union storage_union_t
+{
+    constexpr storage_union_t() noexcept : dummy() {}
+
+    unsigned char dummy;
+    typename std::remove_const<T>::type value;
+};
+
+template< typename T >
+union storage_union_t< T, false >
+{
+    constexpr storage_union_t() noexcept : dummy() {}
+    ~storage_union_t() {}
+
+    unsigned char dummy;
+    typename std::remove_const<T>::type value;
+};
+
+/// storage to hold value.
+
+template< typename T >
+struct storage_t
+{
+#else
+/// C++03 constructed union to hold value.
+
+template< typename T >
+union storage_t
+{
+#endif
+//private:
+//    template< typename > friend class optional;
+
+    typedef T value_type;
+
+    storage_t() optional_is_default
+
+    explicit storage_t( value_type const & v )
+    {
+        construct_value( v );
+    }
+
+    void construct_value( value_type const & v )
+    {
+        ::new( value_ptr() ) value_type( v );
+    }
+
+#if optional_CPP11_OR_GREATER
+
+    explicit storage_t( value_type && v )
+    {
+        construct_value( std::move( v ) );
+    }
+
+    void construct_value( value_type && v )
+    {
+        ::new( const_cast<void *>(static_cast<const volatile void *>(value_ptr())) ) value_type( std::move( v ) );
+    }
+
+    template< class... Args >
+    storage_t( nonstd_lite_in_place_t(T), Args&&... args )
+    {
+        emplace( std::forward<Args>(args)... );
+    }
+
+#if !optional_CONFIG_NO_EXTENSIONS
+    template< class F, class... Args >
+    storage_t( in_place_invoke_t, F && f, Args&&... args )
+    {
+        emplace_with( std::forward<F>(f), std::forward<Args>(args)... );
+    }
+#endif
+
+    template< class... Args >
+    void emplace( Args&&... args )
     {
         ::new( const_cast<void *>(static_cast<const volatile void *>(value_ptr())) ) value_type( std::forward<Args>(args)... );
     }
@@ -818,6 +1436,14 @@ union storage_t
         ::new( const_cast<void *>(static_cast<const volatile void *>(value_ptr())) ) value_type( il, std::forward<Args>(args)... );
     }
 
+    // construct from the result of f( args... ), without a move since C++17:
+
+    template< class F, class... Args >
+    void emplace_with( F && f, Args&&... args )
+    {
+        ::new( const_cast<void *>(static_cast<const volatile void *>(value_ptr())) ) value_type( std::forward<F>(f)( std::forward<Args>(args)... ) );
+    }
+
 #endif
 
     void destruct_value()
@@ -825,6 +1451,17 @@ union storage_t
         value_ptr()->~T();
     }
 
+#if optional_CPP11_OR_GREATER
+    optional_nodiscard value_type const * value_ptr() const
+    {
+        return &data.value;
+    }
+
+    value_type * value_ptr()
+    {
+        return &data.value;
+    }
+#else
     optional_nodiscard value_type const * value_ptr() const
     {
         return as<value_type>();
@@ -834,6 +1471,7 @@ union storage_t
     {
         return as<value_type>();
     }
+#endif
 
     optional_nodiscard value_type const & value() const optional_ref_qual
     {
@@ -861,10 +1499,10 @@ union storage_t
 
 #if optional_CPP11_OR_GREATER
 
-    using aligned_storage_t = typename std::aligned_storage< sizeof(value_type), alignof(value_type) >::type;
-    aligned_storage_t data;
+    storage_union_t< value_type > data;
 
-#elif optional_CONFIG_MAX_ALIGN_HACK
+#else
+#if optional_CONFIG_MAX_ALIGN_HACK
 
     typedef struct { unsigned char data[ sizeof(value_type) ]; } aligned_storage_t;
 
@@ -902,8 +1540,358 @@ union storage_t
     {
         return reinterpret_cast<U const *>( ptr() );
     }
+
+#endif // optional_CPP11_OR_GREATER
+};
+
+/// engagement flag and storage of optional
+
+template< typename T >
+struct optional_data
+{
+    bool has_value_;
+    storage_t< T > contained;
+
+    optional_constexpr optional_data() optional_noexcept
+    : has_value_( false )
+    , contained()
+    {}
+
+#if optional_CPP11_OR_GREATER
+    template< typename... Args >
+    optional_constexpr explicit optional_data( nonstd_lite_in_place_t(T), Args&&... args )
+    : has_value_( true )
+    , contained( nonstd_lite_in_place(T), std::forward<Args>(args)... )
+    {}
+
+#if !optional_CONFIG_NO_EXTENSIONS
+    template< typename F, typename... Args >
+    explicit optional_data( in_place_invoke_t, F && f, Args&&... args )
+    : has_value_( true )
+    , contained( in_place_invoke, std::forward<F>(f), std::forward<Args>(args)... )
+    {}
+#endif
+#else
+    explicit optional_data( T const & value )
+    : has_value_( true )
+    , contained( value )
+    {}
+#endif
+
+    // reset() without recording an instrumentation event:
+
+    void disengage() optional_noexcept
+    {
+        if ( has_value_ )
+        {
+            contained.destruct_value();
+        }
+
+        has_value_ = false;
+    }
+
+    template< typename V >
+    void initialize( V const & value )
+    {
+        assert( ! has_value_ );
+        contained.construct_value( value );
+        has_value_ = true;
+    }
+
+#if optional_CPP11_OR_GREATER
+    template< typename V >
+    void initialize( V && value )
+    {
+        assert( ! has_value_ );
+        contained.construct_value( std::forward<V>( value ) );
+        has_value_ = true;
+    }
+#endif
+};
+
+/// destructor, trivial if T is trivially destructible
+
+template< typename T, bool Trivial = std11::is_trivially_destructible<T>::value && optional_USES_TRIVIAL_MEMBERS >
+struct optional_destruct_base : optional_data<T>
+{
+#if optional_CPP11_OR_GREATER
+    using optional_data<T>::optional_data;
+#endif
+};
+
+template< typename T >
+struct optional_destruct_base< T, false > : optional_data<T>
+{
+#if optional_CPP11_OR_GREATER
+    using optional_data<T>::optional_data;
+
+    optional_destruct_base() = default;
+    optional_destruct_base( optional_destruct_base const & ) = default;
+    optional_destruct_base( optional_destruct_base && ) = default;
+    optional_destruct_base & operator=( optional_destruct_base const & ) = default;
+    optional_destruct_base & operator=( optional_destruct_base && ) = default;
+#else
+    optional_destruct_base()
+    : optional_data<T>()
+    {}
+
+    explicit optional_destruct_base( T const & value )
+    : optional_data<T>( value )
+    {}
+
+    optional_destruct_base( optional_destruct_base const & other )
+    : optional_data<T>()
+    {
+        if ( other.has_value_ )
+        {
+            this->initialize( other.contained.value() );
+        }
+    }
+
+    optional_destruct_base & operator=( optional_destruct_base const & other )
+    {
+        if      ( (this->has_value_ == true ) && (other.has_value_ == false) ) { this->disengage(); }
+        else if ( (this->has_value_ == false) && (other.has_value_ == true ) ) { this->initialize( other.contained.value() ); }
+        else if ( (this->has_value_ == true ) && (other.has_value_ == true ) ) { this->contained.value() = other.contained.value(); }
+        return *this;
+    }
+#endif
+
+    ~optional_destruct_base()
+    {
+        optional_LAYOUT_AUDIT();
+        optional_INSTRUMENT( destruction );
+
+        if ( this->has_value_ )
+        {
+            optional_INSTRUMENT( engaged_destruction );
+            this->contained.destruct_value();
+        }
+    }
+};
+
+#if optional_CPP11_OR_GREATER
+
+// Each of the following bases handles one special member of optional<T>,
+// which is trivial, user-provided or deleted as follows from T:
+
+enum special_member_kind { trivial_member, provided_member, deleted_member };
+
+template< bool Enabled, bool Trivial >
+struct special_member
+{
+    enum { kind = ! Enabled ? deleted_member : Trivial && optional_USES_TRIVIAL_MEMBERS ? trivial_member : provided_member };
+};
+
+/// copy constructor
+
+template< typename T, int Kind = special_member<
+    std::is_copy_constructible<T>::value
+    , std11::is_trivially_copy_constructible<T>::value >::kind >
+struct optional_copy_base : optional_destruct_base<T>
+{
+    using optional_destruct_base<T>::optional_destruct_base;
+};
+
+template< typename T >
+struct optional_copy_base< T, provided_member > : optional_destruct_base<T>
+{
+    using optional_destruct_base<T>::optional_destruct_base;
+
+    optional_copy_base() = default;
+
+    optional_constexpr14 optional_copy_base( optional_copy_base const & other )
+        noexcept( std::is_nothrow_copy_constructible<T>::value )
+    : optional_destruct_base<T>()
+    {
+        optional_INSTRUMENT( copy_construction );
+
+        if ( other.has_value_ )
+        {
+            this->initialize( other.contained.value() );
+        }
+    }
+
+    optional_copy_base( optional_copy_base && ) = default;
+    optional_copy_base & operator=( optional_copy_base const & ) = default;
+    optional_copy_base & operator=( optional_copy_base && ) = default;
+};
+
+template< typename T >
+struct optional_copy_base< T, deleted_member > : optional_destruct_base<T>
+{
+    using optional_destruct_base<T>::optional_destruct_base;
+
+    optional_copy_base() = default;
+    optional_copy_base( optional_copy_base const & ) = delete;
+    optional_copy_base( optional_copy_base && ) = default;
+    optional_copy_base & operator=( optional_copy_base const & ) = default;
+    optional_copy_base & operator=( optional_copy_base && ) = default;
+};
+
+/// move constructor; when deleted, an rvalue optional<T> is copied
+
+template< typename T, int Kind = special_member<
+    std11::is_move_constructible<T>::value
+    , std11::is_trivially_move_constructible<T>::value >::kind >
+struct optional_move_base : optional_copy_base<T>
+{
+    using optional_copy_base<T>::optional_copy_base;
+};
+
+template< typename T >
+struct optional_move_base< T, provided_member > : optional_copy_base<T>
+{
+    using optional_copy_base<T>::optional_copy_base;
+
+    optional_move_base() = default;
+    optional_move_base( optional_move_base const & ) = default;
+
+    optional_constexpr14 optional_move_base( optional_move_base && other )
+        noexcept( std11::is_nothrow_move_constructible<T>::value )
+    : optional_copy_base<T>()
+    {
+        optional_INSTRUMENT( move_construction );
+
+        if ( other.has_value_ )
+        {
+            this->initialize( std::move( other.contained.value() ) );
+        }
+    }
+
+    optional_move_base & operator=( optional_move_base const & ) = default;
+    optional_move_base & operator=( optional_move_base && ) = default;
+};
+
+template< typename T >
+struct optional_move_base< T, deleted_member > : optional_copy_base<T>
+{
+    using optional_copy_base<T>::optional_copy_base;
+
+    optional_move_base() = default;
+    optional_move_base( optional_move_base const & ) = default;
+    optional_move_base( optional_move_base && ) = delete;
+    optional_move_base & operator=( optional_move_base const & ) = default;
+    optional_move_base & operator=( optional_move_base && ) = default;
+};
+
+/// copy assignment
+
+template< typename T, int Kind = special_member<
+    std::is_copy_constructible<T>::value
+    && std::is_copy_assignable<T>::value
+    , std11::is_trivially_copy_constructible<T>::value
+    && std11::is_trivially_copy_assignable<T>::value
+    && std11::is_trivially_destructible<T>::value >::kind >
+struct optional_copy_assign_base : optional_move_base<T>
+{
+    using optional_move_base<T>::optional_move_base;
+};
+
+template< typename T >
+struct optional_copy_assign_base< T, provided_member > : optional_move_base<T>
+{
+    using optional_move_base<T>::optional_move_base;
+
+    optional_copy_assign_base() = default;
+    optional_copy_assign_base( optional_copy_assign_base const & ) = default;
+    optional_copy_assign_base( optional_copy_assign_base && ) = default;
+
+    optional_copy_assign_base & operator=( optional_copy_assign_base const & other )
+        noexcept(
+            std::is_nothrow_copy_constructible<T>::value
+            && std::is_nothrow_copy_assignable<T>::value
+        )
+    {
+        optional_INSTRUMENT( copy_assignment );
+
+        if      ( (this->has_value_ == true ) && (other.has_value_ == false) ) { this->disengage(); }
+        else if ( (this->has_value_ == false) && (other.has_value_ == true ) ) { this->initialize( other.contained.value() ); }
+        else if ( (this->has_value_ == true ) && (other.has_value_ == true ) ) { this->contained.value() = other.contained.value(); }
+        return *this;
+    }
+
+    optional_copy_assign_base & operator=( optional_copy_assign_base && ) = default;
+};
+
+template< typename T >
+struct optional_copy_assign_base< T, deleted_member > : optional_move_base<T>
+{
+    using optional_move_base<T>::optional_move_base;
+
+    optional_copy_assign_base() = default;
+    optional_copy_assign_base( optional_copy_assign_base const & ) = default;
+    optional_copy_assign_base( optional_copy_assign_base && ) = default;
+    optional_copy_assign_base & operator=( optional_copy_assign_base const & ) = delete;
+    optional_copy_assign_base & operator=( optional_copy_assign_base && ) = default;
+};
+
+/// move assignment; when deleted, an rvalue optional<T> is copy-assigned
+
+template< typename T, int Kind = special_member<
+    std11::is_move_constructible<T>::value
+    && std::is_move_assignable<T>::value
+    , std11::is_trivially_move_constructible<T>::value
+    && std11::is_trivially_move_assignable<T>::value
+    && std11::is_trivially_destructible<T>::value >::kind >
+struct optional_move_assign_base : optional_copy_assign_base<T>
+{
+    using optional_copy_assign_base<T>::optional_copy_assign_base;
+};
+
+template< typename T >
+struct optional_move_assign_base< T, provided_member > : optional_copy_assign_base<T>
+{
+    using optional_copy_assign_base<T>::optional_copy_assign_base;
+
+    optional_move_assign_base() = default;
+    optional_move_assign_base( optional_move_assign_base const & ) = default;
+    optional_move_assign_base( optional_move_assign_base && ) = default;
+    optional_move_assign_base & operator=( optional_move_assign_base const & ) = default;
+
+    optional_move_assign_base & operator=( optional_move_assign_base && other )
+        noexcept(
+            std11::is_nothrow_move_assignable<T>::value
+            && std11::is_nothrow_move_constructible<T>::value
+        )
+    {
+        optional_INSTRUMENT( move_assignment );
+
+        if      ( (this->has_value_ == true ) && (other.has_value_ == false) ) { this->disengage(); }
+        else if ( (this->has_value_ == false) && (other.has_value_ == true ) ) { this->initialize( std::move( other.contained.value() ) ); }
+        else if ( (this->has_value_ == true ) && (other.has_value_ == true ) ) { this->contained.value() = std::move( other.contained.value() ); }
+        return *this;
+    }
+};
+
+template< typename T >
+struct optional_move_assign_base< T, deleted_member > : optional_copy_assign_base<T>
+{
+    using optional_copy_assign_base<T>::optional_copy_assign_base;
+
+    optional_move_assign_base() = default;
+    optional_move_assign_base( optional_move_assign_base const & ) = default;
+    optional_move_assign_base( optional_move_assign_base && ) = default;
+    optional_move_assign_base & operator=( optional_move_assign_base const & ) = default;
+    optional_move_assign_base & operator=( optional_move_assign_base && ) = delete;
+};
+
+template< typename T >
+struct optional_base
+{
+    typedef optional_move_assign_base<T> type;
+};
+
+#else // optional_CPP11_OR_GREATER
+
+template< typename T >
+struct optional_base
+{
+    typedef optional_destruct_base<T> type;
 };
 
+#endif // optional_CPP11_OR_GREATER
+
 } // namespace detail
 
 /// disengaged state tag
@@ -925,6 +1913,8 @@ const nullopt_t nullopt(( nullopt_t::init() ));
 
 #if ! optional_CONFIG_NO_EXCEPTIONS
 
+#if optional_CONFIG_BAD_ACCESS_LOGIC_ERROR
+
 class optional_nodiscard bad_optional_access : public std::logic_error
 {
 public:
@@ -932,12 +1922,66 @@ public:
   : logic_error( "bad optional access" ) {}
 };
 
-#endif //optional_CONFIG_NO_EXCEPTIONS
+#else // optional_CONFIG_BAD_ACCESS_LOGIC_ERROR
+
+// as std::bad_optional_access, derive from std::exception: throwing allocates no message
+
+class optional_nodiscard bad_optional_access : public std::exception
+{
+public:
+#if optional_CPP11_OR_GREATER
+    // NOLINTNEXTLINE( modernize-use-nodiscard )
+    const char * what() const noexcept override
+#else
+    virtual const char * what() const throw()
+#endif
+    {
+        return "bad optional access";
+    }
+};
+
+#endif // optional_CONFIG_BAD_ACCESS_LOGIC_ERROR
+#endif // optional_CONFIG_NO_EXCEPTIONS
+
+#if optional_CONFIG_ON_BAD_ACCESS == optional_ON_BAD_ACCESS_HOOK
+
+/// handler for value() of an empty optional, to be defined by the user;
+/// it may throw, it must not return:
+
+void on_bad_access();
+
+#endif
+
+namespace detail {
+
+#if optional_CONFIG_ON_BAD_ACCESS != optional_ON_BAD_ACCESS_ASSERT
+
+// the single, out-of-line failure path of value():
+
+optional_cold_noreturn inline void bad_access()
+{
+#if   optional_CONFIG_ON_BAD_ACCESS == optional_ON_BAD_ACCESS_THROW
+    throw bad_optional_access();
+#elif optional_CONFIG_ON_BAD_ACCESS == optional_ON_BAD_ACCESS_TRAP
+# if optional_COMPILER_GNUC_VERSION || optional_COMPILER_CLANG_VERSION
+    __builtin_trap();
+# else
+    std::abort();
+# endif
+#elif optional_CONFIG_ON_BAD_ACCESS == optional_ON_BAD_ACCESS_HOOK
+    on_bad_access();
+    std::abort();
+#endif
+}
+
+#endif // optional_CONFIG_ON_BAD_ACCESS
+
+} // namespace detail
 
 /// optional
 
 template< typename T>
-class optional
+class optional : private detail::optional_base<T>::type
 {
     optional_static_assert(( !std::is_same<typename std::remove_cv<T>::type, nullopt_t>::value  ),
         "T in optional<T> must not be of type 'nullopt_t'.")
@@ -951,6 +1995,8 @@ class optional
 private:
     template< typename > friend class optional;
 
+    typedef typename detail::optional_base<T>::type base_type;
+
     typedef void (optional::*safe_bool)() const;
 
 public:
@@ -958,56 +2004,26 @@ public:
 
      // x.x.3.1, constructors
 
-    // 1a - default construct
-    optional_constexpr optional() optional_noexcept
-    : has_value_( false )
-    , contained()
-    {}
-
+    // 1a - default construct
+    optional_constexpr_ctor optional() optional_noexcept
+    : base_type()
+    {
+        optional_INSTRUMENT( default_construction );
+    }
+
     // 1b - construct explicitly empty
     // NOLINTNEXTLINE( google-explicit-constructor, hicpp-explicit-conversions )
-    optional_constexpr optional( nullopt_t /*unused*/ ) optional_noexcept
-    : has_value_( false )
-    , contained()
-    {}
-
-    // 2 - copy-construct
-#if optional_CPP11_OR_GREATER
-    // template< typename U = T
-    //     optional_REQUIRES_T(
-    //         std::is_copy_constructible<U>::value
-    //         || std11::is_trivially_copy_constructible<U>::value
-    //     )
-    // >
-#endif
-    optional_constexpr14 optional( optional const & other )
-    : has_value_( other.has_value() )
+    optional_constexpr_ctor optional( nullopt_t /*unused*/ ) optional_noexcept
+    : base_type()
     {
-        if ( other.has_value() )
-        {
-            contained.construct_value( other.contained.value() );
-        }
+        optional_INSTRUMENT( default_construction );
     }
 
+    // 2 - copy-construct: trivial, user-provided or deleted as follows from T, see detail::optional_copy_base
+
 #if optional_CPP11_OR_GREATER
 
-    // 3 (C++11) - move-construct from optional
-    template< typename U = T
-        optional_REQUIRES_T(
-            std11::is_move_constructible<U>::value
-            || std11::is_trivially_move_constructible<U>::value
-        )
-    >
-    optional_constexpr14 optional( optional && other )
-    // NOLINTNEXTLINE( performance-noexcept-move-constructor )
-        noexcept( std11::is_nothrow_move_constructible<T>::value )
-    : has_value_( other.has_value() )
-    {
-        if ( other.has_value() )
-        {
-            contained.construct_value( std::move( other.contained.value() ) );
-        }
-    }
+    // 3 (C++11) - move-construct from optional: see detail::optional_move_base
 
     // 4a (C++11) - explicit converting copy-construct from optional
     template< typename U
@@ -1025,11 +2041,13 @@ public:
         )
     >
     explicit optional( optional<U> const & other )
-    : has_value_( other.has_value() )
+    : base_type()
     {
+        optional_INSTRUMENT( copy_construction );
+
         if ( other.has_value() )
         {
-            contained.construct_value( T{ other.contained.value() } );
+            initialize( T{ other.contained.value() } );
         }
     }
 #endif // optional_CPP11_OR_GREATER
@@ -1053,11 +2071,13 @@ public:
     >
     // NOLINTNEXTLINE( google-explicit-constructor, hicpp-explicit-conversions )
     /*non-explicit*/ optional( optional<U> const & other )
-    : has_value_( other.has_value() )
+    : base_type()
     {
+        optional_INSTRUMENT( copy_construction );
+
         if ( other.has_value() )
         {
-            contained.construct_value( other.contained.value() );
+            initialize( other.contained.value() );
         }
     }
 
@@ -1080,11 +2100,13 @@ public:
     >
     explicit optional( optional<U> && other
     )
-    : has_value_( other.has_value() )
+    : base_type()
     {
+        optional_INSTRUMENT( move_construction );
+
         if ( other.has_value() )
         {
-            contained.construct_value( T{ std::move( other.contained.value() ) } );
+            initialize( T{ std::move( other.contained.value() ) } );
         }
     }
 
@@ -1105,11 +2127,13 @@ public:
     >
     // NOLINTNEXTLINE( google-explicit-constructor, hicpp-explicit-conversions )
     /*non-explicit*/ optional( optional<U> && other )
-    : has_value_( other.has_value() )
+    : base_type()
     {
+        optional_INSTRUMENT( move_construction );
+
         if ( other.has_value() )
         {
-            contained.construct_value( std::move( other.contained.value() ) );
+            initialize( std::move( other.contained.value() ) );
         }
     }
 
@@ -1119,10 +2143,11 @@ public:
             std::is_constructible<T, Args&&...>::value
         )
     >
-    optional_constexpr explicit optional( nonstd_lite_in_place_t(T), Args&&... args )
-    : has_value_( true )
-    , contained( in_place, std::forward<Args>(args)... )
-    {}
+    optional_constexpr_ctor explicit optional( nonstd_lite_in_place_t(T), Args&&... args )
+    : base_type( nonstd_lite_in_place(T), std::forward<Args>(args)... )
+    {
+        optional_INSTRUMENT( value_construction );
+    }
 
     // 7 (C++11) - in-place construct,  initializer-list
     template< typename U, typename... Args
@@ -1130,10 +2155,21 @@ public:
             std::is_constructible<T, std::initializer_list<U>&, Args&&...>::value
         )
     >
-    optional_constexpr explicit optional( nonstd_lite_in_place_t(T), std::initializer_list<U> il, Args&&... args )
-    : has_value_( true )
-    , contained( T( il, std::forward<Args>(args)...) )
-    {}
+    optional_constexpr_ctor explicit optional( nonstd_lite_in_place_t(T), std::initializer_list<U> il, Args&&... args )
+    : base_type( nonstd_lite_in_place(T), T( il, std::forward<Args>(args)...) )
+    {
+        optional_INSTRUMENT( value_construction );
+    }
+
+#if !optional_CONFIG_NO_EXTENSIONS
+    // 7a (C++11) - in-place construct from the result of f( args... ), without a move since C++17 [extension]
+    template< typename F, typename... Args >
+    explicit optional( in_place_invoke_t, F && f, Args&&... args )
+    : base_type( in_place_invoke, std::forward<F>(f), std::forward<Args>(args)... )
+    {
+        optional_INSTRUMENT( value_construction );
+    }
+#endif
 
     // 8a (C++11) - explicit move construct from value
     template< typename U = T
@@ -1144,10 +2180,11 @@ public:
             && !std::is_convertible<U&&, T>::value /*=> explicit */
         )
     >
-    optional_constexpr explicit optional( U && value )
-    : has_value_( true )
-    , contained( nonstd_lite_in_place(T), std::forward<U>( value ) )
-    {}
+    optional_constexpr_ctor explicit optional( U && value )
+    : base_type( nonstd_lite_in_place(T), std::forward<U>( value ) )
+    {
+        optional_INSTRUMENT( value_construction );
+    }
 
     // 8b (C++11) - non-explicit move construct from value
     template< typename U = T
@@ -1159,30 +2196,22 @@ public:
         )
     >
     // NOLINTNEXTLINE( google-explicit-constructor, hicpp-explicit-conversions )
-    optional_constexpr /*non-explicit*/ optional( U && value )
-    : has_value_( true )
-    , contained( nonstd_lite_in_place(T), std::forward<U>( value ) )
-    {}
+    optional_constexpr_ctor /*non-explicit*/ optional( U && value )
+    : base_type( nonstd_lite_in_place(T), std::forward<U>( value ) )
+    {
+        optional_INSTRUMENT( value_construction );
+    }
 
 #else // optional_CPP11_OR_GREATER
 
     // 8 (C++98)
     optional( value_type const & value )
-    : has_value_( true )
-    , contained( value )
+    : base_type( value )
     {}
 
 #endif // optional_CPP11_OR_GREATER
 
-    // x.x.3.2, destructor
-
-    ~optional()
-    {
-        if ( has_value() )
-        {
-            contained.destruct_value();
-        }
-    }
+    // x.x.3.2, destructor: trivial if T is trivially destructible, see detail::optional_destruct_base
 
     // x.x.3.3, assignment
 
@@ -1193,47 +2222,11 @@ public:
         return *this;
     }
 
-    // 2 (C++98and later) - copy-assign from optional
-#if optional_CPP11_OR_GREATER
-    // NOLINTNEXTLINE( cppcoreguidelines-c-copy-assignment-signature, misc-unconventional-assign-operator )
-    optional_REQUIRES_R(
-        optional &,
-        true
-//      std::is_copy_constructible<T>::value
-//      && std::is_copy_assignable<T>::value
-    )
-    operator=( optional const & other )
-        noexcept(
-            std11::is_nothrow_move_assignable<T>::value
-            && std11::is_nothrow_move_constructible<T>::value
-        )
-#else
-    optional & operator=( optional const & other )
-#endif
-    {
-        if      ( (has_value() == true ) && (other.has_value() == false) ) { reset(); }
-        else if ( (has_value() == false) && (other.has_value() == true ) ) { initialize( *other ); }
-        else if ( (has_value() == true ) && (other.has_value() == true ) ) { contained.value() = *other; }
-        return *this;
-    }
+    // 2 (C++98and later) - copy-assign from optional: see detail::optional_copy_assign_base
 
 #if optional_CPP11_OR_GREATER
 
-    // 3 (C++11) - move-assign from optional
-    // NOLINTNEXTLINE( cppcoreguidelines-c-copy-assignment-signature, misc-unconventional-assign-operator )
-    optional_REQUIRES_R(
-        optional &,
-        true
-//      std11::is_move_constructible<T>::value
-//      && std::is_move_assignable<T>::value
-    )
-    operator=( optional && other ) noexcept
-    {
-        if      ( (has_value() == true ) && (other.has_value() == false) ) { reset(); }
-        else if ( (has_value() == false) && (other.has_value() == true ) ) { initialize( std::move( *other ) ); }
-        else if ( (has_value() == true ) && (other.has_value() == true ) ) { contained.value() = std::move( *other ); }
-        return *this;
-    }
+    // 3 (C++11) - move-assign from optional: see detail::optional_move_assign_base
 
     // 4 (C++11) - move-assign from value
     template< typename U = T >
@@ -1248,6 +2241,8 @@ public:
         )
     operator=( U && value )
     {
+        optional_INSTRUMENT( value_assignment );
+
         if ( has_value() )
         {
             contained.value() = std::forward<U>( value );
@@ -1336,7 +2331,8 @@ public:
     >
     T& emplace( Args&&... args )
     {
-        *this = nullopt;
+        optional_INSTRUMENT( emplace_call );
+        disengage();
         contained.emplace( std::forward<Args>(args)...  );
         has_value_ = true;
         return contained.value();
@@ -1350,7 +2346,8 @@ public:
     >
     T& emplace( std::initializer_list<U> il, Args&&... args )
     {
-        *this = nullopt;
+        optional_INSTRUMENT( emplace_call );
+        disengage();
         contained.emplace( il, std::forward<Args>(args)...  );
         has_value_ = true;
         return contained.value();
@@ -1368,12 +2365,38 @@ public:
         )
 #endif
     {
-        using std::swap;
-        if      ( (has_value() == true ) && (other.has_value() == true ) ) { swap( **this, *other ); }
-        else if ( (has_value() == false) && (other.has_value() == true ) ) { initialize( std11::move(*other) ); other.reset(); }
-        else if ( (has_value() == true ) && (other.has_value() == false) ) { other.initialize( std11::move(**this) ); reset(); }
+        swap_with( other, is_trivially_copyable_payload() );
+    }
+
+#if !optional_CONFIG_NO_EXTENSIONS
+
+    // iterator support (extension, as C++26): a contiguous range of zero or one element
+
+    typedef value_type       * iterator;
+    typedef value_type const * const_iterator;
+
+    iterator begin() optional_noexcept
+    {
+        return contained.value_ptr();
+    }
+
+    const_iterator begin() const optional_noexcept
+    {
+        return contained.value_ptr();
+    }
+
+    iterator end() optional_noexcept
+    {
+        return begin() + has_value();
+    }
+
+    const_iterator end() const optional_noexcept
+    {
+        return begin() + has_value();
     }
 
+#endif // optional_CONFIG_NO_EXTENSIONS
+
     // x.x.3.5, observers
 
     optional_constexpr value_type const * operator ->() const
@@ -1435,12 +2458,13 @@ public:
     // NOLINTNEXTLINE( modernize-use-nodiscard )
     /*optional_nodiscard*/ optional_constexpr14 value_type const & value() const optional_ref_qual
     {
-#if optional_CONFIG_NO_EXCEPTIONS
+#if optional_CONFIG_ON_BAD_ACCESS == optional_ON_BAD_ACCESS_ASSERT
         assert( has_value() );
 #else
         if ( ! has_value() )
         {
-            throw bad_optional_access();
+            optional_INSTRUMENT( bad_access );
+            detail::bad_access();
         }
 #endif
         return contained.value();
@@ -1448,12 +2472,13 @@ public:
 
     optional_constexpr14 value_type & value() optional_ref_qual
     {
-#if optional_CONFIG_NO_EXCEPTIONS
+#if optional_CONFIG_ON_BAD_ACCESS == optional_ON_BAD_ACCESS_ASSERT
         assert( has_value() );
 #else
         if ( ! has_value() )
         {
-            throw bad_optional_access();
+            optional_INSTRUMENT( bad_access );
+            detail::bad_access();
         }
 #endif
         return contained.value();
@@ -1533,50 +2558,276 @@ public:
     }
 
 #endif //  optional_HAVE( REF_QUALIFIER )
+
+    // the value or fallback, without a copy; the result refers to fallback
+    // if empty, so it must not outlive a temporary fallback:
+
+    optional_constexpr value_type const & value_or_ref( value_type const & fallback ) const optional_ref_qual
+    {
+        return has_value() ? contained.value() : fallback;
+    }
+
+#if optional_HAVE( REF_QUALIFIER )
+    value_type const & value_or_ref( value_type const & fallback ) const optional_refref_qual = delete;
+#endif
+
+#if optional_CPP11_OR_GREATER
+    // a temporary fallback would dangle if empty:
+
+    value_type const & value_or_ref( value_type && fallback ) const = delete;
+#endif
+
 #endif // !optional_CONFIG_NO_EXTENSIONS
 
     // x.x.3.6, modifiers
 
     void reset() optional_noexcept
     {
-        if ( has_value() )
+        optional_INSTRUMENT( reset_call );
+        disengage();
+    }
+
+#if !optional_CONFIG_NO_EXTENSIONS
+
+    // ownership transfer (extension), each with a single engagement check:
+
+    // move the value out, leaving *this empty:
+
+    optional take()
+    {
+        optional result;
+        if ( has_value_ )
         {
+            optional_INSTRUMENT( reset_call );
+#if optional_CPP11_OR_GREATER
+            result.initialize( std::move( contained.value() ) );
+#else
+            result.initialize( contained.value() );
+#endif
             contained.destruct_value();
+            has_value_ = false;
         }
-
-        has_value_ = false;
+        return result;
     }
 
-private:
-    void this_type_does_not_support_comparisons() const {}
+#if optional_CPP11_OR_GREATER
 
-    template< typename V >
-    void initialize( V const & value )
+    // emplace a new value and return the old one, if any:
+
+    template< typename... Args
+        optional_REQUIRES_T(
+            std::is_constructible<T, Args&&...>::value
+        )
+    >
+    optional replace( Args&&... args )
     {
-        assert( ! has_value()  );
-        contained.construct_value( value );
+        optional_INSTRUMENT( emplace_call );
+        optional result;
+        if ( has_value_ )
+        {
+            result.initialize( std::move( contained.value() ) );
+            contained.destruct_value();
+            has_value_ = false;
+        }
+        contained.emplace( std::forward<Args>(args)... );
         has_value_ = true;
+        return result;
     }
 
-#if optional_CPP11_OR_GREATER
-    template< typename V >
-    void initialize( V && value )
+    // the value, emplaced from args if empty:
+
+    template< typename... Args
+        optional_REQUIRES_T(
+            std::is_constructible<T, Args&&...>::value
+        )
+    >
+    T& get_or_emplace( Args&&... args )
     {
-        assert( ! has_value()  );
-        contained.construct_value( std::forward<V>( value ) );
+        if ( ! has_value_ )
+        {
+            optional_INSTRUMENT( emplace_call );
+            contained.emplace( std::forward<Args>(args)... );
+            has_value_ = true;
+        }
+        return contained.value();
+    }
+
+    // construct the value in place from the result of f( args... ), without a move since C++17:
+
+    template< typename F, typename... Args >
+    T& emplace_with( F && f, Args&&... args )
+    {
+        optional_INSTRUMENT( emplace_call );
+        disengage();
+        contained.emplace_with( std::forward<F>(f), std::forward<Args>(args)... );
         has_value_ = true;
+        return contained.value();
     }
 
-#endif
+    // the value, constructed in place from the result of f() if empty:
+
+    template< typename F >
+    T& get_or_emplace_with( F && f )
+    {
+        if ( ! has_value_ )
+        {
+            optional_INSTRUMENT( emplace_call );
+            contained.emplace_with( std::forward<F>(f) );
+            has_value_ = true;
+        }
+        return contained.value();
+    }
+
+#endif // optional_CPP11_OR_GREATER
+#endif // !optional_CONFIG_NO_EXTENSIONS
 
 private:
-    bool has_value_;
-    detail::storage_t< value_type > contained;
+    void this_type_does_not_support_comparisons() const {}
+
+    // For a trivially copyable payload, swap transfers the engagement flag and
+    // the raw storage unconditionally, without branching on the engagement
+    // state of either side (copy and move are trivial then):
+
+    typedef std11::bool_constant< std11::is_trivially_copyable<T>::value > is_trivially_copyable_payload;
+
+#if defined(__GNUC__) && !defined(__clang__)
+# pragma GCC diagnostic push
+# pragma GCC diagnostic ignored "-Wmaybe-uninitialized"   // storage copy of a disengaged payload
+#endif
+
+    void swap_with( optional & other, std11::true_type /*trivial*/ )
+    {
+        bool const has_value = has_value_;
+        detail::storage_t< value_type > const tmp = contained;
+
+        has_value_ = other.has_value_;
+        contained  = other.contained;
+
+        other.has_value_ = has_value;
+        other.contained  = tmp;
+    }
 
+#if defined(__GNUC__) && !defined(__clang__)
+# pragma GCC diagnostic pop
+#endif
+
+    void swap_with( optional & other, std11::false_type /*trivial*/ )
+    {
+        using std::swap;
+        if      ( (has_value() == true ) && (other.has_value() == true ) ) { swap( **this, *other ); }
+        else if ( (has_value() == false) && (other.has_value() == true ) ) { initialize( std11::move(*other) ); other.disengage(); }
+        else if ( (has_value() == true ) && (other.has_value() == false) ) { other.initialize( std11::move(**this) ); disengage(); }
+    }
+
+private:
+    using base_type::has_value_;
+    using base_type::contained;
+    using base_type::initialize;
+    using base_type::disengage;
 };
 
 // Relational operators
 
+#if optional_HAVE( THREE_WAY_COMPARISON )
+
+// C++20: only operator== and operator<=> are defined; the compiler rewrites
+// !=, <, <=, >, >= and the reversed argument orders in terms of these, and
+// orders two engaged optionals with a single three-way comparison of their
+// values. A value type with only operator< is ordered via that operator:
+
+namespace detail {
+
+template< typename T >
+struct is_optional : std::false_type {};
+
+template< typename T >
+struct is_optional< optional<T> > : std::true_type {};
+
+template< typename T, typename U >
+concept has_equal = requires( T const & t, U const & u ) { { t == u } -> std::convertible_to<bool>; };
+
+template< typename T, typename U >
+concept has_three_way = requires( T const & t, U const & u ) { t <=> u; };
+
+template< typename T, typename U >
+concept has_less = requires( T const & t, U const & u ) { bool( t < u ); bool( u < t ); };
+
+struct synth_three_way
+{
+    template< typename T, typename U >
+        requires has_three_way<T, U> || has_less<T, U>
+    constexpr auto operator()( T const & t, U const & u ) const
+    {
+        if constexpr ( has_three_way<T, U> )
+        {
+            return t <=> u;
+        }
+        else
+        {
+            return t < u ? std::weak_ordering::less : u < t ? std::weak_ordering::greater : std::weak_ordering::equivalent;
+        }
+    }
+};
+
+template< typename T, typename U >
+using synth_three_way_result = decltype( synth_three_way()( std::declval<T const &>(), std::declval<U const &>() ) );
+
+} // namespace detail
+
+template< typename T, typename U >
+    requires detail::has_equal<T, U>
+optional_nodiscard constexpr bool operator==( optional<T> const & x, optional<U> const & y )
+{
+    return bool(x) != bool(y) ? false : !bool( x ) ? true : *x == *y;
+}
+
+template< typename T, typename U >
+    requires detail::has_three_way<T, U> || detail::has_less<T, U>
+optional_nodiscard constexpr detail::synth_three_way_result<T, U> operator<=>( optional<T> const & x, optional<U> const & y )
+{
+    if ( !y )
+    {
+        return bool(x) <=> false;
+    }
+    if ( !x )
+    {
+        return std::strong_ordering::less;
+    }
+    return detail::synth_three_way()( *x, *y );
+}
+
+// Comparison with nullopt
+
+template< typename T >
+optional_nodiscard constexpr bool operator==( optional<T> const & x, nullopt_t /*unused*/ ) noexcept
+{
+    return (!x);
+}
+
+template< typename T >
+optional_nodiscard constexpr std::strong_ordering operator<=>( optional<T> const & x, nullopt_t /*unused*/ ) noexcept
+{
+    return bool(x) <=> false;
+}
+
+// Comparison with T
+
+template< typename T, typename U >
+    requires ( !detail::is_optional<U>::value ) && detail::has_equal<T, U>
+optional_nodiscard constexpr bool operator==( optional<T> const & x, U const & v )
+{
+    return bool(x) ? *x == v : false;
+}
+
+template< typename T, typename U >
+    requires ( !detail::is_optional<U>::value ) && ( detail::has_three_way<T, U> || detail::has_less<T, U> )
+optional_nodiscard constexpr detail::synth_three_way_result<T, U> operator<=>( optional<T> const & x, U const & v )
+{
+    return bool(x) ? detail::synth_three_way()( *x, v ) : std::strong_ordering::less;
+}
+
+#else // optional_HAVE( THREE_WAY_COMPARISON )
+
 template< typename T, typename U >
 optional_nodiscard optional_constexpr bool operator==( optional<T> const & x, optional<U> const & y )
 {
@@ -1761,6 +3012,8 @@ optional_nodiscard optional_constexpr bool operator>=( U const & v, optional<T>
     return bool(x) ? v >= *x : true;
 }
 
+#endif // optional_HAVE( THREE_WAY_COMPARISON )
+
 // Specialized algorithms
 
 template< typename T
@@ -1820,6 +3073,19 @@ using optional_lite::bad_optional_access;
 
 using optional_lite::make_optional;
 
+#if optional_CPP11_OR_GREATER && !optional_CONFIG_NO_EXTENSIONS
+using optional_lite::in_place_invoke_t;
+using optional_lite::in_place_invoke;
+#endif
+
+#if optional_USES_INSTRUMENT
+namespace instrument = optional_lite::instrument;
+#endif
+
+#if optional_USES_LAYOUT_AUDIT
+namespace layout = optional_lite::layout;
+#endif
+
 } // namespace nonstd
 
 #if optional_CPP11_OR_GREATER
@@ -0,0 +1,335 @@
+//
+// Copyright (c) 2026 Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#ifndef NONSTD_OPTIONAL_ARROW_LITE_HPP
+#define NONSTD_OPTIONAL_ARROW_LITE_HPP
+
+#include "nonstd/optional_columns.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdint.h>
+#include <string>
+
+//
+// Exchange of optional columns via the Apache Arrow C data interface:
+//
+// export_arrow() moves an optional_columns<T> into an ArrowArray and describes
+// it in an ArrowSchema, without copying the buffers: the validity words of the
+// columns are an Arrow validity bitmap on little-endian platforms. The release
+// callbacks of the structs free the columns and the schema.
+//
+// import_arrow() checks that an ArrowArray/ArrowSchema pair is a primitive
+// array of T and returns a read-only view of it as optional<T> elements. The
+// view does not take ownership: the producer's array must outlive it, and
+// remains to be released by its owner.
+//
+// Only the ABI-stable structs of the interface are used, so no Arrow library
+// is needed. See https://arrow.apache.org/docs/format/CDataInterface.html
+//
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+# error optional_arrow.hpp requires a little-endian platform
+#endif
+
+// The structs of the C data interface, as specified:
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+
+struct ArrowSchema
+{
+    // Array type description
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+struct ArrowArray
+{
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+} // extern "C"
+
+#endif // ARROW_C_DATA_INTERFACE
+
+namespace nonstd { namespace optional_lite {
+
+namespace detail {
+
+// the Arrow format string of a primitive type:
+
+template< typename T >
+char const * arrow_format() noexcept
+{
+    static_assert( std::is_arithmetic<T>::value && !std::is_same<T, bool>::value,
+        "Arrow export and import require optional<T> with T arithmetic, not bool" );
+    static_assert( !std::is_floating_point<T>::value || sizeof( T ) == 4 || sizeof( T ) == 8,
+        "Arrow export and import require float or double" );
+
+    return std::is_floating_point<T>::value ? ( sizeof( T ) == 4 ? "f" : "g" )
+        : std::is_signed<T>::value
+            ? ( sizeof( T ) == 1 ? "c" : sizeof( T ) == 2 ? "s" : sizeof( T ) == 4 ? "i" : "l" )
+            : ( sizeof( T ) == 1 ? "C" : sizeof( T ) == 2 ? "S" : sizeof( T ) == 4 ? "I" : "L" );
+}
+
+template< typename T >
+struct arrow_array_data
+{
+    optional_columns<T> columns;
+    void const * buffers[2];
+};
+
+struct arrow_schema_data
+{
+    std::string name;
+};
+
+template< typename T >
+void release_arrow_array( ArrowArray * array )
+{
+    delete static_cast< arrow_array_data<T> * >( array->private_data );
+    array->release = nullptr;
+}
+
+inline void release_arrow_schema( ArrowSchema * schema )
+{
+    delete static_cast< arrow_schema_data * >( schema->private_data );
+    schema->release = nullptr;
+}
+
+} // namespace detail
+
+/// move columns into array, and describe them in schema as a nullable field
+/// named name; the consumer releases both structs:
+
+template< typename T >
+void export_arrow( optional_columns<T> columns, ArrowArray * array, ArrowSchema * schema, char const * name = "" )
+{
+    std::unique_ptr< detail::arrow_array_data<T> > data( new detail::arrow_array_data<T>() );
+    std::unique_ptr< detail::arrow_schema_data > meta( new detail::arrow_schema_data() );
+
+    meta->name = name;
+
+    int64_t const length = static_cast<int64_t>( columns.size() );
+    int64_t const nulls = length - static_cast<int64_t>( columns.count_engaged() );
+
+    data->columns = std::move( columns );
+    data->buffers[0] = data->columns.validity.data();
+    data->buffers[1] = data->columns.values.data();
+
+    schema->format       = detail::arrow_format<T>();
+    schema->name         = meta->name.c_str();
+    schema->metadata     = nullptr;
+    schema->flags        = ARROW_FLAG_NULLABLE;
+    schema->n_children   = 0;
+    schema->children     = nullptr;
+    schema->dictionary   = nullptr;
+    schema->release      = &detail::release_arrow_schema;
+    schema->private_data = meta.release();
+
+    array->length        = length;
+    array->null_count    = nulls;
+    array->offset        = 0;
+    array->n_buffers     = 2;
+    array->n_children    = 0;
+    array->buffers       = data->buffers;
+    array->children      = nullptr;
+    array->dictionary    = nullptr;
+    array->release       = &detail::release_arrow_array<T>;
+    array->private_data  = data.release();
+}
+
+/// class arrow_optional_view
+///
+/// A read-only view of a primitive Arrow array of T as a sequence of
+/// optional<T>; obtained from import_arrow().
+
+template< typename T >
+class arrow_optional_view
+{
+public:
+    typedef optional<T>     value_type;
+    typedef std::size_t     size_type;
+
+    class const_iterator;
+
+    explicit arrow_optional_view( ArrowArray const & array ) noexcept
+    : validity_( static_cast<unsigned char const *>( array.buffers[0] ) )
+    , values_( static_cast<T const *>( array.buffers[1] ) + array.offset )
+    , offset_( static_cast<size_type>( array.offset ) )
+    , size_( static_cast<size_type>( array.length ) )
+    {}
+
+    size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    bool has_value( size_type i ) const noexcept
+    {
+        assert( i < size_ );
+
+        size_type const bit = offset_ + i;
+
+        return validity_ == nullptr || ( ( validity_[ bit / 8 ] >> ( bit % 8 ) ) & 1u );
+    }
+
+    value_type operator[]( size_type i ) const noexcept
+    {
+        return has_value( i ) ? value_type( values_[i] ) : value_type();
+    }
+
+    // the values buffer, including the unspecified values of empty elements:
+
+    T const * data() const noexcept
+    {
+        return values_;
+    }
+
+    const_iterator begin() const noexcept;
+    const_iterator end()   const noexcept;
+
+private:
+    unsigned char const * validity_;    // null if all elements are engaged
+    T const * values_;
+    size_type offset_;
+    size_type size_;
+};
+
+/// forward iterator yielding optional<T> by value
+
+template< typename T >
+class arrow_optional_view<T>::const_iterator
+{
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef optional<T>               value_type;
+    typedef std::ptrdiff_t            difference_type;
+    typedef void                      pointer;
+    typedef value_type                reference;
+
+    const_iterator() noexcept
+    : view_( nullptr ), pos_( 0 )
+    {}
+
+    value_type operator*() const noexcept
+    {
+        return ( *view_ )[ pos_ ];
+    }
+
+    const_iterator & operator++() noexcept
+    {
+        ++pos_;
+        return *this;
+    }
+
+    const_iterator operator++( int ) noexcept
+    {
+        const_iterator tmp( *this );
+        ++pos_;
+        return tmp;
+    }
+
+    friend bool operator==( const_iterator const & a, const_iterator const & b ) noexcept
+    {
+        return a.pos_ == b.pos_;
+    }
+
+    friend bool operator!=( const_iterator const & a, const_iterator const & b ) noexcept
+    {
+        return !( a == b );
+    }
+
+private:
+    friend class arrow_optional_view;
+
+    const_iterator( arrow_optional_view const * view, size_type pos ) noexcept
+    : view_( view ), pos_( pos )
+    {}
+
+    arrow_optional_view const * view_;
+    size_type pos_;
+};
+
+template< typename T >
+inline typename arrow_optional_view<T>::const_iterator arrow_optional_view<T>::begin() const noexcept
+{
+    return const_iterator( this, 0 );
+}
+
+template< typename T >
+inline typename arrow_optional_view<T>::const_iterator arrow_optional_view<T>::end() const noexcept
+{
+    return const_iterator( this, size_ );
+}
+
+/// a view of array as optional<T> if schema describes a primitive array of T
+/// and array is not released, nullopt otherwise:
+
+template< typename T >
+optional< arrow_optional_view<T> > import_arrow( ArrowArray const & array, ArrowSchema const & schema )
+{
+    bool const valid =
+        array.release != nullptr && schema.release != nullptr
+        && schema.format != nullptr && std::strcmp( schema.format, detail::arrow_format<T>() ) == 0
+        && schema.dictionary == nullptr && schema.n_children == 0
+        && array.n_buffers == 2 && array.n_children == 0
+        && array.length >= 0 && array.offset >= 0
+        && ( array.length == 0 || array.buffers[1] != nullptr );
+
+    return valid ? optional< arrow_optional_view<T> >( arrow_optional_view<T>( array ) ) : nullopt;
+}
+
+}} // namespace nonstd::optional_lite
+
+namespace nonstd {
+
+using optional_lite::export_arrow;
+using optional_lite::import_arrow;
+using optional_lite::arrow_optional_view;
+
+} // namespace nonstd
+
+#endif // optional_CPP11_OR_GREATER
+
+#endif // NONSTD_OPTIONAL_ARROW_LITE_HPP
@@ -0,0 +1,52 @@
+//
+// Copyright (c) 2026 Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#ifndef NONSTD_OPTIONAL_BITS_LITE_HPP
+#define NONSTD_OPTIONAL_BITS_LITE_HPP
+
+#include "nonstd/optional.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+// Bit operations on 64-bit words, shared by the packed containers of optionals:
+
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+# include <intrin.h>
+#endif
+
+namespace nonstd { namespace optional_lite {
+
+namespace detail {
+
+// Population count of a 64-bit word:
+
+inline int popcount64( std::uint64_t x ) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll( x );
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<int>( __popcnt64( x ) );
+#else
+    x = x - ( ( x >> 1 ) & 0x5555555555555555ull );
+    x = ( x & 0x3333333333333333ull ) + ( ( x >> 2 ) & 0x3333333333333333ull );
+    x = ( x + ( x >> 4 ) ) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<int>( ( x * 0x0101010101010101ull ) >> 56 );
+#endif
+}
+
+} // namespace detail
+
+}} // namespace nonstd::optional_lite
+
+#endif // optional_CPP11_OR_GREATER
+
+#endif // NONSTD_OPTIONAL_BITS_LITE_HPP
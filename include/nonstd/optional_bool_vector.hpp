@@ -0,0 +1,482 @@
+//
+// Copyright (c) 2026 Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#ifndef NONSTD_OPTIONAL_BOOL_VECTOR_LITE_HPP
+#define NONSTD_OPTIONAL_BOOL_VECTOR_LITE_HPP
+
+#include "nonstd/optional.hpp"
+#include "nonstd/optional_bits.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+namespace nonstd { namespace optional_lite {
+
+/// class optional_bool_vector
+///
+/// A sequence of optional<bool> that uses two bits per element. Elements are
+/// kept in two bit-planes per 64-element block: 'engaged' and 'value', where
+/// the value bit of an empty element is always zero. This allows word-wise
+/// counting and three-valued (Kleene) logic without unpacking the elements.
+
+class optional_bool_vector
+{
+public:
+    typedef optional<bool>  value_type;
+    typedef std::size_t     size_type;
+    typedef std::ptrdiff_t  difference_type;
+    typedef std::uint64_t   word_type;
+
+    enum { bits_per_word = 64 };
+
+    class reference;
+    class const_iterator;
+
+    optional_bool_vector() noexcept
+    : size_( 0 )
+    {}
+
+    explicit optional_bool_vector( size_type n, value_type const & v = nullopt )
+    : size_( 0 )
+    {
+        resize( n, v );
+    }
+
+    optional_bool_vector( std::initializer_list<value_type> il )
+    : size_( 0 )
+    {
+        assign( il.begin(), il.end() );
+    }
+
+    template< typename InputIt >
+    optional_bool_vector( InputIt first, InputIt last )
+    : size_( 0 )
+    {
+        assign( first, last );
+    }
+
+    template< typename InputIt >
+    void assign( InputIt first, InputIt last )
+    {
+        clear();
+        for ( ; first != last; ++first )
+        {
+            push_back( *first );
+        }
+    }
+
+    // capacity:
+
+    size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    void reserve( size_type n )
+    {
+        blocks_.reserve( block_count( n ) );
+    }
+
+    // Memory in use by the element storage, in bytes:
+
+    size_type memory_size() const noexcept
+    {
+        return blocks_.capacity() * sizeof( block );
+    }
+
+    // element access:
+
+    value_type operator[]( size_type pos ) const
+    {
+        return get( pos );
+    }
+
+    reference operator[]( size_type pos );
+
+    value_type get( size_type pos ) const
+    {
+        assert( pos < size_ );
+
+        block const & b = blocks_[ pos / bits_per_word ];
+        word_type const m = mask( pos );
+
+        return ( b.engaged & m ) ? value_type( ( b.value & m ) != 0 ) : value_type();
+    }
+
+    void set( size_type pos, value_type const & v )
+    {
+        assert( pos < size_ );
+
+        block & b = blocks_[ pos / bits_per_word ];
+        word_type const m = mask( pos );
+
+        b.engaged = v.has_value() ? ( b.engaged | m ) : ( b.engaged & ~m );
+        b.value   = v.has_value() && *v ? ( b.value | m ) : ( b.value & ~m );
+    }
+
+    void reset( size_type pos )
+    {
+        set( pos, nullopt );
+    }
+
+    value_type front() const { return get( 0 ); }
+    value_type back()  const { return get( size_ - 1 ); }
+
+    // iterators:
+
+    const_iterator begin()  const noexcept;
+    const_iterator end()    const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend()   const noexcept;
+
+    // modifiers:
+
+    void clear() noexcept
+    {
+        blocks_.clear();
+        size_ = 0;
+    }
+
+    void push_back( value_type const & v )
+    {
+        if ( size_ % bits_per_word == 0 )
+        {
+            blocks_.push_back( block() );
+        }
+        ++size_;
+        set( size_ - 1, v );
+    }
+
+    void pop_back()
+    {
+        assert( size_ > 0 );
+        resize( size_ - 1 );
+    }
+
+    void resize( size_type n, value_type const & v = nullopt )
+    {
+        size_type const old_size = size_;
+
+        blocks_.resize( block_count( n ) );
+        size_ = n;
+
+        if ( n < old_size )
+        {
+            clear_tail();
+        }
+        else if ( v.has_value() )
+        {
+            for ( size_type i = old_size; i < n; ++i )
+            {
+                set( i, v );
+            }
+        }
+    }
+
+    void swap( optional_bool_vector & other ) noexcept
+    {
+        blocks_.swap( other.blocks_ );
+        std::swap( size_, other.size_ );
+    }
+
+    // Queries by word-level population count:
+
+    size_type count_true() const noexcept
+    {
+        size_type n = 0;
+        for ( block const & b : blocks_ )
+        {
+            n += static_cast<size_type>( detail::popcount64( b.value ) );
+        }
+        return n;
+    }
+
+    size_type count_false() const noexcept
+    {
+        size_type n = 0;
+        for ( block const & b : blocks_ )
+        {
+            n += static_cast<size_type>( detail::popcount64( b.engaged & ~b.value ) );
+        }
+        return n;
+    }
+
+    size_type count_engaged() const noexcept
+    {
+        size_type n = 0;
+        for ( block const & b : blocks_ )
+        {
+            n += static_cast<size_type>( detail::popcount64( b.engaged ) );
+        }
+        return n;
+    }
+
+    size_type count_empty() const noexcept
+    {
+        return size_ - count_engaged();
+    }
+
+    // Three-valued (Kleene) logic, element-wise; sizes must be equal:
+    //
+    //   and: false if either is false, true if both are true, else empty.
+    //   or : true if either is true, false if both are false, else empty.
+    //   not: swaps true and false, empty stays empty.
+
+    optional_bool_vector & operator&=( optional_bool_vector const & other ) noexcept
+    {
+        assert( size_ == other.size_ );
+
+        for ( size_type i = 0; i < blocks_.size(); ++i )
+        {
+            block & a = blocks_[i];
+            block const & b = other.blocks_[i];
+
+            word_type const t = a.value & b.value;
+            word_type const f = ( a.engaged & ~a.value ) | ( b.engaged & ~b.value );
+
+            a.engaged = t | f;
+            a.value   = t;
+        }
+        return *this;
+    }
+
+    optional_bool_vector & operator|=( optional_bool_vector const & other ) noexcept
+    {
+        assert( size_ == other.size_ );
+
+        for ( size_type i = 0; i < blocks_.size(); ++i )
+        {
+            block & a = blocks_[i];
+            block const & b = other.blocks_[i];
+
+            word_type const t = a.value | b.value;
+            word_type const f = ( a.engaged & ~a.value ) & ( b.engaged & ~b.value );
+
+            a.engaged = t | f;
+            a.value   = t;
+        }
+        return *this;
+    }
+
+    optional_bool_vector & flip() noexcept
+    {
+        for ( block & b : blocks_ )
+        {
+            b.value = b.engaged & ~b.value;
+        }
+        return *this;
+    }
+
+    friend bool operator==( optional_bool_vector const & x, optional_bool_vector const & y ) noexcept
+    {
+        if ( x.size_ != y.size_ )
+        {
+            return false;
+        }
+
+        for ( size_type i = 0; i < x.blocks_.size(); ++i )
+        {
+            if ( x.blocks_[i].engaged != y.blocks_[i].engaged || x.blocks_[i].value != y.blocks_[i].value )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend bool operator!=( optional_bool_vector const & x, optional_bool_vector const & y ) noexcept
+    {
+        return !( x == y );
+    }
+
+private:
+    struct block
+    {
+        word_type engaged;
+        word_type value;
+
+        block() noexcept : engaged( 0 ), value( 0 ) {}
+    };
+
+    static size_type block_count( size_type n ) noexcept
+    {
+        return ( n + bits_per_word - 1 ) / bits_per_word;
+    }
+
+    static word_type mask( size_type pos ) noexcept
+    {
+        return word_type( 1 ) << ( pos % bits_per_word );
+    }
+
+    // keep bits beyond size() zero, so that counting needs no masking:
+
+    void clear_tail() noexcept
+    {
+        size_type const used = size_ % bits_per_word;
+
+        if ( used != 0 )
+        {
+            word_type const keep = ( word_type( 1 ) << used ) - 1;
+
+            blocks_.back().engaged &= keep;
+            blocks_.back().value   &= keep;
+        }
+    }
+
+private:
+    std::vector<block> blocks_;
+    size_type size_;
+};
+
+/// proxy reference to an element of optional_bool_vector
+
+class optional_bool_vector::reference
+{
+public:
+    reference( reference const & ) = default;
+
+    reference & operator=( value_type const & v )
+    {
+        vec_->set( pos_, v );
+        return *this;
+    }
+
+    reference & operator=( reference const & other )
+    {
+        return *this = static_cast<value_type>( other );
+    }
+
+    operator value_type() const
+    {
+        return vec_->get( pos_ );
+    }
+
+private:
+    friend class optional_bool_vector;
+
+    reference( optional_bool_vector * vec, size_type pos ) noexcept
+    : vec_( vec )
+    , pos_( pos )
+    {}
+
+    optional_bool_vector * vec_;
+    size_type pos_;
+};
+
+inline optional_bool_vector::reference optional_bool_vector::operator[]( size_type pos )
+{
+    assert( pos < size_ );
+    return reference( this, pos );
+}
+
+/// random-access iterator yielding optional<bool> by value
+
+class optional_bool_vector::const_iterator
+{
+public:
+    typedef std::random_access_iterator_tag  iterator_category;
+    typedef optional_bool_vector::value_type value_type;
+    typedef std::ptrdiff_t                   difference_type;
+    typedef value_type const *               pointer;
+    typedef value_type                       reference;
+
+    const_iterator() noexcept
+    : vec_( nullptr )
+    , pos_( 0 )
+    {}
+
+    reference operator*() const { return vec_->get( pos_ ); }
+    reference operator[]( difference_type n ) const { return *( *this + n ); }
+
+    const_iterator & operator++() noexcept { ++pos_; return *this; }
+    const_iterator & operator--() noexcept { --pos_; return *this; }
+    const_iterator   operator++( int ) noexcept { const_iterator t( *this ); ++pos_; return t; }
+    const_iterator   operator--( int ) noexcept { const_iterator t( *this ); --pos_; return t; }
+
+    const_iterator & operator+=( difference_type n ) noexcept { pos_ = static_cast<size_type>( static_cast<difference_type>( pos_ ) + n ); return *this; }
+    const_iterator & operator-=( difference_type n ) noexcept { return *this += -n; }
+
+    friend const_iterator  operator+( const_iterator it, difference_type n ) noexcept { return it += n; }
+    friend const_iterator  operator+( difference_type n, const_iterator it ) noexcept { return it += n; }
+    friend const_iterator  operator-( const_iterator it, difference_type n ) noexcept { return it -= n; }
+    friend difference_type operator-( const_iterator const & a, const_iterator const & b ) noexcept
+    {
+        return static_cast<difference_type>( a.pos_ ) - static_cast<difference_type>( b.pos_ );
+    }
+
+    friend bool operator==( const_iterator const & a, const_iterator const & b ) noexcept { return a.pos_ == b.pos_; }
+    friend bool operator!=( const_iterator const & a, const_iterator const & b ) noexcept { return a.pos_ != b.pos_; }
+    friend bool operator< ( const_iterator const & a, const_iterator const & b ) noexcept { return a.pos_ <  b.pos_; }
+    friend bool operator> ( const_iterator const & a, const_iterator const & b ) noexcept { return a.pos_ >  b.pos_; }
+    friend bool operator<=( const_iterator const & a, const_iterator const & b ) noexcept { return a.pos_ <= b.pos_; }
+    friend bool operator>=( const_iterator const & a, const_iterator const & b ) noexcept { return a.pos_ >= b.pos_; }
+
+private:
+    friend class optional_bool_vector;
+
+    const_iterator( optional_bool_vector const * vec, size_type pos ) noexcept
+    : vec_( vec )
+    , pos_( pos )
+    {}
+
+    optional_bool_vector const * vec_;
+    size_type pos_;
+};
+
+inline optional_bool_vector::const_iterator optional_bool_vector::begin()  const noexcept { return const_iterator( this, 0 ); }
+inline optional_bool_vector::const_iterator optional_bool_vector::end()    const noexcept { return const_iterator( this, size_ ); }
+inline optional_bool_vector::const_iterator optional_bool_vector::cbegin() const noexcept { return begin(); }
+inline optional_bool_vector::const_iterator optional_bool_vector::cend()   const noexcept { return end(); }
+
+// Three-valued logic operators:
+
+inline optional_bool_vector operator&( optional_bool_vector x, optional_bool_vector const & y )
+{
+    x &= y;
+    return x;
+}
+
+inline optional_bool_vector operator|( optional_bool_vector x, optional_bool_vector const & y )
+{
+    x |= y;
+    return x;
+}
+
+inline optional_bool_vector operator~( optional_bool_vector x )
+{
+    x.flip();
+    return x;
+}
+
+inline void swap( optional_bool_vector & x, optional_bool_vector & y ) noexcept
+{
+    x.swap( y );
+}
+
+} // namespace optional_lite
+
+using optional_lite::optional_bool_vector;
+
+} // namespace nonstd
+
+#endif // optional_CPP11_OR_GREATER
+
+#endif // NONSTD_OPTIONAL_BOOL_VECTOR_LITE_HPP
@@ -0,0 +1,539 @@
+//
+// Copyright (c) 2026 Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#ifndef NONSTD_OPTIONAL_BOXED_LITE_HPP
+#define NONSTD_OPTIONAL_BOXED_LITE_HPP
+
+#include "nonstd/optional.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nonstd { namespace optional_lite {
+
+namespace detail {
+
+/// size_class_pool: fixed-size slots, carved from chunks that are never
+/// returned to the system; freed slots are kept on a free list for reuse.
+
+template< std::size_t Size >
+class size_class_pool
+{
+public:
+    enum { slots_per_chunk = 64 };
+
+    static size_class_pool & instance()
+    {
+        // leaked: slots may be released during static destruction:
+        static size_class_pool * pool = new size_class_pool();
+        return *pool;
+    }
+
+    void * allocate()
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+
+        if ( free_ == nullptr )
+        {
+            grow();
+        }
+
+        slot * s = free_;
+        free_ = s->next;
+        return s;
+    }
+
+    void deallocate( void * p ) noexcept
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+
+        slot * s = static_cast<slot *>( p );
+        s->next = free_;
+        free_ = s;
+    }
+
+    // bytes obtained from the system:
+
+    std::size_t reserved() const
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        return chunks_.size() * slots_per_chunk * sizeof( slot );
+    }
+
+private:
+    union slot
+    {
+        slot * next;
+        alignas( std::max_align_t ) unsigned char storage[ Size ];
+    };
+
+    size_class_pool() = default;
+
+    void grow()
+    {
+        slot * chunk = static_cast<slot *>( ::operator new( slots_per_chunk * sizeof( slot ) ) );
+        chunks_.push_back( chunk );
+
+        for ( std::size_t i = 0; i < slots_per_chunk; ++i )
+        {
+            chunk[i].next = free_;
+            free_ = &chunk[i];
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<slot *> chunks_;
+    slot * free_ = nullptr;
+};
+
+// sizes rounded up to a multiple of 16 bytes share a pool:
+
+template< typename T >
+using size_class_pool_of = size_class_pool< ( sizeof( T ) + 15 ) / 16 * 16 >;
+
+} // namespace detail
+
+/// pool_allocator: allocates single objects from the size-class pool of
+/// their type; other requests go to operator new.
+
+template< typename T >
+class pool_allocator
+{
+public:
+    typedef T value_type;
+
+    pool_allocator() = default;
+
+    template< typename U >
+    pool_allocator( pool_allocator<U> const & ) noexcept {}
+
+    T * allocate( std::size_t n )
+    {
+        if ( n == 1 && alignof( T ) <= alignof( std::max_align_t ) )
+        {
+            return static_cast<T *>( detail::size_class_pool_of<T>::instance().allocate() );
+        }
+        return static_cast<T *>( ::operator new( n * sizeof( T ) ) );
+    }
+
+    void deallocate( T * p, std::size_t n ) noexcept
+    {
+        if ( n == 1 && alignof( T ) <= alignof( std::max_align_t ) )
+        {
+            detail::size_class_pool_of<T>::instance().deallocate( p );
+        }
+        else
+        {
+            ::operator delete( p );
+        }
+    }
+
+    // bytes reserved by the pool of T's size class:
+
+    static std::size_t pool_reserved()
+    {
+        return detail::size_class_pool_of<T>::instance().reserved();
+    }
+
+    friend bool operator==( pool_allocator const &, pool_allocator const & ) noexcept { return true; }
+    friend bool operator!=( pool_allocator const &, pool_allocator const & ) noexcept { return false; }
+};
+
+/// class boxed_optional
+///
+/// An optional<T> that keeps an engaged value out of line, allocated by
+/// Allocator, so that it is the size of a pointer. For large payloads that
+/// are rarely engaged. Accessors and comparisons are those of optional<T>;
+/// copying copies the value into a new allocation, moving transfers it.
+
+template< typename T, typename Allocator = pool_allocator<T> >
+class boxed_optional : private std::allocator_traits<Allocator>::template rebind_alloc<T>
+{
+    typedef typename std::allocator_traits<Allocator>::template rebind_alloc<T> allocator_type;
+    typedef std::allocator_traits<allocator_type> traits;
+
+public:
+    typedef T value_type;
+
+    boxed_optional() noexcept {}
+
+    boxed_optional( nullopt_t ) noexcept {}
+
+    boxed_optional( boxed_optional const & other )
+    : allocator_type( traits::select_on_container_copy_construction( other.allocator() ) )
+    {
+        if ( other )
+        {
+            ptr_ = create( *other );
+        }
+    }
+
+    boxed_optional( boxed_optional && other ) noexcept
+    : allocator_type( std::move( other.allocator() ) )
+    , ptr_( other.ptr_ )
+    {
+        other.ptr_ = nullptr;
+    }
+
+    // explicit if U does not convert to T, as for optional:
+
+    template< typename U = T
+        , typename std::enable_if<
+            std::is_constructible<T, U&&>::value
+            && !std::is_same<typename std::decay<U>::type, boxed_optional>::value
+            && !std::is_same<typename std::decay<U>::type, nullopt_t>::value
+            && !std::is_same<typename std::decay<U>::type, optional<T> >::value
+            && !std::is_convertible<U&&, T>::value /*=> explicit */, int >::type = 0
+    >
+    explicit boxed_optional( U && value )
+    : ptr_( create( std::forward<U>( value ) ) )
+    {}
+
+    template< typename U = T
+        , typename std::enable_if<
+            std::is_constructible<T, U&&>::value
+            && !std::is_same<typename std::decay<U>::type, boxed_optional>::value
+            && !std::is_same<typename std::decay<U>::type, nullopt_t>::value
+            && !std::is_same<typename std::decay<U>::type, optional<T> >::value
+            && std::is_convertible<U&&, T>::value /*=> non-explicit */, int >::type = 0
+    >
+    boxed_optional( U && value )
+    : ptr_( create( std::forward<U>( value ) ) )
+    {}
+
+    template< typename... Args >
+    explicit boxed_optional( nonstd_lite_in_place_t( T ), Args &&... args )
+    : ptr_( create( std::forward<Args>( args )... ) )
+    {}
+
+    explicit boxed_optional( optional<T> const & other )
+    : ptr_( other ? create( *other ) : nullptr )
+    {}
+
+    explicit boxed_optional( optional<T> && other )
+    : ptr_( other ? create( std::move( *other ) ) : nullptr )
+    {}
+
+    ~boxed_optional()
+    {
+        reset();
+    }
+
+    boxed_optional & operator=( nullopt_t ) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    boxed_optional & operator=( boxed_optional const & other )
+    {
+        if ( this != &other )
+        {
+            if ( ptr_ && other.ptr_ ) *ptr_ = *other.ptr_;
+            else if ( other.ptr_ )    ptr_ = create( *other.ptr_ );
+            else                      reset();
+        }
+        return *this;
+    }
+
+    boxed_optional & operator=( boxed_optional && other ) noexcept
+    {
+        swap( other );
+        other.reset();
+        return *this;
+    }
+
+    template< typename U = T
+        , typename std::enable_if<
+            std::is_constructible<T, U&&>::value && std::is_assignable<T&, U&&>::value
+            && !std::is_same<typename std::decay<U>::type, boxed_optional>::value
+            && !std::is_same<typename std::decay<U>::type, nullopt_t>::value, int >::type = 0
+    >
+    boxed_optional & operator=( U && value )
+    {
+        if ( ptr_ ) *ptr_ = std::forward<U>( value );
+        else        ptr_ = create( std::forward<U>( value ) );
+        return *this;
+    }
+
+    template< typename... Args >
+    T & emplace( Args &&... args )
+    {
+        reset();
+        ptr_ = create( std::forward<Args>( args )... );
+        return *ptr_;
+    }
+
+    void reset() noexcept
+    {
+        if ( ptr_ )
+        {
+            traits::destroy( allocator(), ptr_ );
+            traits::deallocate( allocator(), ptr_, 1 );
+            ptr_ = nullptr;
+        }
+    }
+
+    void swap( boxed_optional & other ) noexcept
+    {
+        using std::swap;
+        swap( allocator(), other.allocator() );
+        swap( ptr_, other.ptr_ );
+    }
+
+    // observers:
+
+    bool has_value() const noexcept
+    {
+        return ptr_ != nullptr;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return has_value();
+    }
+
+    T const * operator->() const
+    {
+        return assert( has_value() ), ptr_;
+    }
+
+    T * operator->()
+    {
+        return assert( has_value() ), ptr_;
+    }
+
+    T const & operator*() const
+    {
+        return assert( has_value() ), *ptr_;
+    }
+
+    T & operator*()
+    {
+        return assert( has_value() ), *ptr_;
+    }
+
+    T const & value() const
+    {
+        check();
+        return *ptr_;
+    }
+
+    T & value()
+    {
+        check();
+        return *ptr_;
+    }
+
+    template< typename U >
+    T value_or( U && v ) const
+    {
+        return has_value() ? *ptr_ : static_cast<T>( std::forward<U>( v ) );
+    }
+
+    // conversion to an inline optional:
+
+    optional<T> to_optional() const
+    {
+        return has_value() ? optional<T>( *ptr_ ) : optional<T>();
+    }
+
+private:
+    template< typename... Args >
+    T * create( Args &&... args )
+    {
+        T * p = traits::allocate( allocator(), 1 );
+#if optional_CONFIG_NO_EXCEPTIONS
+        traits::construct( allocator(), p, std::forward<Args>( args )... );
+#else
+        try
+        {
+            traits::construct( allocator(), p, std::forward<Args>( args )... );
+        }
+        catch ( ... )
+        {
+            traits::deallocate( allocator(), p, 1 );
+            throw;
+        }
+#endif
+        return p;
+    }
+
+    // respond to access of an empty boxed_optional as value() of optional does:
+
+    void check() const
+    {
+#if optional_CONFIG_ON_BAD_ACCESS == optional_ON_BAD_ACCESS_ASSERT
+        assert( has_value() );
+#else
+        if ( !has_value() )
+        {
+# if optional_USES_STD_OPTIONAL
+            throw bad_optional_access();
+# else
+            detail::bad_access();
+# endif
+        }
+#endif
+    }
+
+    allocator_type & allocator() noexcept
+    {
+        return *this;
+    }
+
+    allocator_type const & allocator() const noexcept
+    {
+        return *this;
+    }
+
+    T * ptr_ = nullptr;
+};
+
+template< typename T, typename A >
+inline void swap( boxed_optional<T, A> & x, boxed_optional<T, A> & y ) noexcept
+{
+    x.swap( y );
+}
+
+// relational operators, as those of optional: empty compares less than any value:
+
+template< typename T, typename A >
+bool operator==( boxed_optional<T, A> const & x, boxed_optional<T, A> const & y )
+{
+    return bool( x ) != bool( y ) ? false : !x || *x == *y;
+}
+
+template< typename T, typename A >
+bool operator!=( boxed_optional<T, A> const & x, boxed_optional<T, A> const & y )
+{
+    return !( x == y );
+}
+
+template< typename T, typename A >
+bool operator<( boxed_optional<T, A> const & x, boxed_optional<T, A> const & y )
+{
+    return !y ? false : !x ? true : *x < *y;
+}
+
+template< typename T, typename A >
+bool operator>( boxed_optional<T, A> const & x, boxed_optional<T, A> const & y )
+{
+    return y < x;
+}
+
+template< typename T, typename A >
+bool operator<=( boxed_optional<T, A> const & x, boxed_optional<T, A> const & y )
+{
+    return !( y < x );
+}
+
+template< typename T, typename A >
+bool operator>=( boxed_optional<T, A> const & x, boxed_optional<T, A> const & y )
+{
+    return !( x < y );
+}
+
+// comparison with nullopt:
+
+template< typename T, typename A >
+bool operator==( boxed_optional<T, A> const & x, nullopt_t ) noexcept { return !x; }
+
+template< typename T, typename A >
+bool operator==( nullopt_t, boxed_optional<T, A> const & x ) noexcept { return !x; }
+
+template< typename T, typename A >
+bool operator!=( boxed_optional<T, A> const & x, nullopt_t ) noexcept { return bool( x ); }
+
+template< typename T, typename A >
+bool operator!=( nullopt_t, boxed_optional<T, A> const & x ) noexcept { return bool( x ); }
+
+template< typename T, typename A >
+bool operator<( boxed_optional<T, A> const &, nullopt_t ) noexcept { return false; }
+
+template< typename T, typename A >
+bool operator<( nullopt_t, boxed_optional<T, A> const & x ) noexcept { return bool( x ); }
+
+template< typename T, typename A >
+bool operator<=( boxed_optional<T, A> const & x, nullopt_t ) noexcept { return !x; }
+
+template< typename T, typename A >
+bool operator<=( nullopt_t, boxed_optional<T, A> const & ) noexcept { return true; }
+
+template< typename T, typename A >
+bool operator>( boxed_optional<T, A> const & x, nullopt_t ) noexcept { return bool( x ); }
+
+template< typename T, typename A >
+bool operator>( nullopt_t, boxed_optional<T, A> const & ) noexcept { return false; }
+
+template< typename T, typename A >
+bool operator>=( boxed_optional<T, A> const &, nullopt_t ) noexcept { return true; }
+
+template< typename T, typename A >
+bool operator>=( nullopt_t, boxed_optional<T, A> const & x ) noexcept { return !x; }
+
+// comparison with a value:
+
+template< typename T, typename A, typename U >
+bool operator==( boxed_optional<T, A> const & x, U const & v ) { return bool( x ) ? *x == v : false; }
+
+template< typename T, typename A, typename U >
+bool operator==( U const & v, boxed_optional<T, A> const & x ) { return bool( x ) ? v == *x : false; }
+
+template< typename T, typename A, typename U >
+bool operator!=( boxed_optional<T, A> const & x, U const & v ) { return bool( x ) ? *x != v : true; }
+
+template< typename T, typename A, typename U >
+bool operator!=( U const & v, boxed_optional<T, A> const & x ) { return bool( x ) ? v != *x : true; }
+
+template< typename T, typename A, typename U >
+bool operator<( boxed_optional<T, A> const & x, U const & v ) { return bool( x ) ? *x < v : true; }
+
+template< typename T, typename A, typename U >
+bool operator<( U const & v, boxed_optional<T, A> const & x ) { return bool( x ) ? v < *x : false; }
+
+template< typename T, typename A, typename U >
+bool operator<=( boxed_optional<T, A> const & x, U const & v ) { return bool( x ) ? *x <= v : true; }
+
+template< typename T, typename A, typename U >
+bool operator<=( U const & v, boxed_optional<T, A> const & x ) { return bool( x ) ? v <= *x : false; }
+
+template< typename T, typename A, typename U >
+bool operator>( boxed_optional<T, A> const & x, U const & v ) { return bool( x ) ? *x > v : false; }
+
+template< typename T, typename A, typename U >
+bool operator>( U const & v, boxed_optional<T, A> const & x ) { return bool( x ) ? v > *x : true; }
+
+template< typename T, typename A, typename U >
+bool operator>=( boxed_optional<T, A> const & x, U const & v ) { return bool( x ) ? *x >= v : false; }
+
+template< typename T, typename A, typename U >
+bool operator>=( U const & v, boxed_optional<T, A> const & x ) { return bool( x ) ? v >= *x : true; }
+
+}} // namespace nonstd::optional_lite
+
+namespace nonstd {
+
+using optional_lite::boxed_optional;
+using optional_lite::pool_allocator;
+
+} // namespace nonstd
+
+#endif // optional_CPP11_OR_GREATER
+
+#endif // NONSTD_OPTIONAL_BOXED_LITE_HPP
@@ -0,0 +1,211 @@
+//
+// Copyright (c) 2026 Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#ifndef NONSTD_OPTIONAL_COLUMNS_LITE_HPP
+#define NONSTD_OPTIONAL_COLUMNS_LITE_HPP
+
+#include "nonstd/optional_mask.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <algorithm>
+#include <cassert>
+#include <type_traits>
+#include <utility>
+
+//
+// Conversion between rows, a vector of optional<T>, and columns, a values
+// array of the same length plus a validity bitmap, as in Apache Arrow:
+//
+// Both directions work in blocks of 64 elements, the elements of one word of
+// the validity bitmap. A block whose elements are all engaged is copied by a
+// loop without branches, which compilers vectorize for trivially copyable T;
+// a block without engaged elements is skipped; the engaged elements of other
+// blocks are visited by counting trailing zeros. Conversions from an rvalue
+// move the values rather than copying them.
+//
+
+namespace nonstd { namespace optional_lite {
+
+/// struct optional_columns
+///
+/// A sequence of optional<T> as values and a validity bitmap: bit i % 64 of
+/// validity[ i / 64 ] is set if element i is engaged, and values[i] is its
+/// value; the values of empty elements are T().
+
+template< typename T >
+struct optional_columns
+{
+    typedef std::size_t size_type;
+
+    std::vector<T> values;
+    std::vector<std::uint64_t> validity;
+
+    size_type size() const noexcept
+    {
+        return values.size();
+    }
+
+    bool has_value( size_type i ) const noexcept
+    {
+        return assert( i < size() ), ( validity[ i / 64 ] >> ( i % 64 ) ) & 1u;
+    }
+
+    optional<T> operator[]( size_type i ) const
+    {
+        return has_value( i ) ? optional<T>( values[i] ) : optional<T>();
+    }
+
+    size_type count_engaged() const noexcept
+    {
+        size_type count = 0;
+        for ( auto word : validity )
+        {
+            count += static_cast<size_type>( detail::popcount64( word ) );
+        }
+        return count;
+    }
+};
+
+namespace detail {
+
+template< typename Iterator >
+using row_value_t = typename std::decay< decltype( **std::declval<Iterator>() ) >::type;
+
+// assign the values of the engaged rows of first[0, n) to out[0, n), given
+// their engagement word; Value is T const & to copy or T && to move:
+
+template< typename Value, typename Iterator, typename T >
+void gather_block( Iterator first, std::size_t n, std::uint64_t word, T * out )
+{
+    typedef typename std::iterator_traits<Iterator>::difference_type difference_type;
+
+    if ( n == 64 && word == ~std::uint64_t( 0 ) )
+    {
+        for ( std::size_t j = 0; j < 64; ++j )
+        {
+            out[j] = static_cast<Value>( *first[ static_cast<difference_type>( j ) ] );
+        }
+        return;
+    }
+
+    for ( ; word != 0; word &= word - 1 )
+    {
+        std::size_t const j = static_cast<std::size_t>( ctz64( word ) );
+        out[j] = static_cast<Value>( *first[ static_cast<difference_type>( j ) ] );
+    }
+}
+
+template< typename Value, typename Iterator >
+optional_columns< row_value_t<Iterator> > to_columns( Iterator first, Iterator last )
+{
+    typedef row_value_t<Iterator> T;
+    typedef typename std::iterator_traits<Iterator>::difference_type difference_type;
+
+    std::size_t const n = static_cast<std::size_t>( last - first );
+
+    optional_columns<T> result;
+    result.values.resize( n );
+    result.validity.reserve( ( n + 63 ) / 64 );
+
+    for_each_engaged_word( first, last, [&]( std::size_t i, std::uint64_t word )
+    {
+        result.validity.push_back( word );
+        gather_block<Value>( first + static_cast<difference_type>( i ), (std::min)( n - i, std::size_t( 64 ) ), word, result.values.data() + i );
+    } );
+
+    return result;
+}
+
+// Values is std::vector<T> const to copy or std::vector<T> to move:
+
+template< typename Value, typename Values >
+std::vector< optional< typename Values::value_type > > to_rows( Values & values, std::vector<std::uint64_t> const & validity )
+{
+    typedef typename Values::value_type T;
+
+    std::size_t const n = values.size();
+    std::vector< optional<T> > result( n );
+
+    for ( std::size_t i = 0; i < n; i += 64 )
+    {
+        std::uint64_t word = validity[ i / 64 ];
+
+        if ( n - i >= 64 && word == ~std::uint64_t( 0 ) )
+        {
+            for ( std::size_t j = i; j < i + 64; ++j )
+            {
+                result[j] = static_cast<Value>( values[j] );
+            }
+            continue;
+        }
+
+        for ( ; word != 0; word &= word - 1 )
+        {
+            std::size_t const j = i + static_cast<std::size_t>( ctz64( word ) );
+            result[j] = static_cast<Value>( values[j] );
+        }
+    }
+    return result;
+}
+
+} // namespace detail
+
+/// the optionals of [first, last) as columns:
+
+template< typename Iterator >
+optional_columns< detail::row_value_t<Iterator> > to_columns( Iterator first, Iterator last )
+{
+    return detail::to_columns< detail::row_value_t<Iterator> const & >( first, last );
+}
+
+template< typename T >
+optional_columns<T> to_columns( std::vector< optional<T> > const & rows )
+{
+    return detail::to_columns<T const &>( rows.begin(), rows.end() );
+}
+
+/// the optionals of rows as columns, moving the values:
+
+template< typename T >
+optional_columns<T> to_columns( std::vector< optional<T> > && rows )
+{
+    return detail::to_columns<T &&>( rows.begin(), rows.end() );
+}
+
+/// columns as a vector of optionals:
+
+template< typename T >
+std::vector< optional<T> > to_rows( optional_columns<T> const & columns )
+{
+    return detail::to_rows<T const &>( columns.values, columns.validity );
+}
+
+/// columns as a vector of optionals, moving the values:
+
+template< typename T >
+std::vector< optional<T> > to_rows( optional_columns<T> && columns )
+{
+    return detail::to_rows<T &&>( columns.values, columns.validity );
+}
+
+}} // namespace nonstd::optional_lite
+
+namespace nonstd {
+
+using optional_lite::optional_columns;
+using optional_lite::to_columns;
+using optional_lite::to_rows;
+
+} // namespace nonstd
+
+#endif // optional_CPP11_OR_GREATER
+
+#endif // NONSTD_OPTIONAL_COLUMNS_LITE_HPP
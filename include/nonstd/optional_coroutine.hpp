@@ -0,0 +1,198 @@
+//
+// Copyright (c) 2026 Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#ifndef NONSTD_OPTIONAL_COROUTINE_LITE_HPP
+#define NONSTD_OPTIONAL_COROUTINE_LITE_HPP
+
+#include "nonstd/optional.hpp"
+
+// Coroutines require C++20; std::coroutine_traits is specialized for nonstd::optional only.
+// Clang before 17 converts the return object eagerly (see below), so with it an optional
+// cannot be the return type of a coroutine (Apple clang before 17 is excluded as well):
+
+#if optional_HAVE_COROUTINES && ! optional_USES_STD_OPTIONAL && ( ! defined( __clang__ ) || __clang_major__ >= 17 )
+# define optional_USES_COROUTINE  1
+#else
+# define optional_USES_COROUTINE  0
+#endif
+
+#if optional_USES_COROUTINE
+
+#include <coroutine>
+#include <utility>
+
+//
+// An optional-returning function becomes a coroutine when it uses co_await or
+// co_return. co_await on an engaged optional yields its value; co_await on an
+// empty optional ends the coroutine, which then returns nullopt:
+//
+//     optional<int> sum( optional<int> a, optional<int> b )
+//     {
+//         co_return co_await a + co_await b;
+//     }
+//
+// The coroutine runs to completion before it returns and never suspends. Its
+// frame does not escape the call, so compilers that elide coroutine frame
+// allocations (such as clang at -O2) can place it on the caller's stack.
+//
+// The promise produces its optional via a return object that the compiler
+// converts to optional<T> when the coroutine returns, as GCC, MSVC and clang 17
+// and later do. An exception that leaves the body propagates to the caller
+// from unhandled_exception(); as the coroutine has not suspended, its frame is
+// then destroyed before the exception leaves the call.
+//
+
+namespace nonstd { namespace optional_lite {
+
+namespace detail {
+
+// co_await on an lvalue optional yields a reference to its value:
+
+template< typename U >
+struct optional_ref_awaiter
+{
+    U * value;
+
+    bool await_ready() const noexcept
+    {
+        return value != nullptr;
+    }
+
+    template< typename Promise >
+    void await_suspend( std::coroutine_handle<Promise> coroutine ) const noexcept
+    {
+        coroutine.destroy();
+    }
+
+    U & await_resume() const noexcept
+    {
+        return *value;
+    }
+};
+
+// co_await on an rvalue optional yields its value, moved out:
+
+template< typename U >
+struct optional_value_awaiter
+{
+    optional<U> & opt;
+
+    bool await_ready() const noexcept
+    {
+        return opt.has_value();
+    }
+
+    template< typename Promise >
+    void await_suspend( std::coroutine_handle<Promise> coroutine ) const noexcept
+    {
+        coroutine.destroy();
+    }
+
+    U await_resume()
+    {
+        return std::move( *opt );
+    }
+};
+
+// holds the result while the coroutine runs; neither copyable nor movable,
+// so that it stays where the promise can find it:
+
+template< typename T >
+class optional_return
+{
+public:
+    explicit optional_return( optional<T> * & result ) noexcept
+    {
+        result = &value_;
+    }
+
+    optional_return( optional_return const & ) = delete;
+    optional_return & operator=( optional_return const & ) = delete;
+
+    operator optional<T>()
+    {
+        return std::move( value_ );
+    }
+
+private:
+    optional<T> value_;
+};
+
+template< typename T >
+class optional_promise
+{
+public:
+    optional_return<T> get_return_object() noexcept
+    {
+        return optional_return<T>( result_ );
+    }
+
+    std::suspend_never initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    std::suspend_never final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    template< typename U = T >
+    void return_value( U && value )
+    {
+        *result_ = std::forward<U>( value );
+    }
+
+    void unhandled_exception()
+    {
+        throw;
+    }
+
+    // only optionals can be awaited:
+
+    template< typename U >
+    optional_ref_awaiter<U> await_transform( optional<U> & opt ) const noexcept
+    {
+        return { opt.has_value() ? &*opt : nullptr };
+    }
+
+    template< typename U >
+    optional_ref_awaiter<U const> await_transform( optional<U> const & opt ) const noexcept
+    {
+        return { opt.has_value() ? &*opt : nullptr };
+    }
+
+    template< typename U >
+    optional_value_awaiter<U> await_transform( optional<U> && opt ) const noexcept
+    {
+        return { opt };
+    }
+
+private:
+    optional<T> * result_ = nullptr;
+};
+
+} // namespace detail
+
+}} // namespace nonstd::optional_lite
+
+namespace std {
+
+template< typename T, typename... Args >
+struct coroutine_traits< nonstd::optional_lite::optional<T>, Args... >
+{
+    using promise_type = nonstd::optional_lite::detail::optional_promise<T>;
+};
+
+} // namespace std
+
+#endif // optional_USES_COROUTINE
+
+#endif // NONSTD_OPTIONAL_COROUTINE_LITE_HPP
@@ -0,0 +1,248 @@
+//
+// Copyright (c) 2026 Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#ifndef NONSTD_OPTIONAL_FORMAT_LITE_HPP
+#define NONSTD_OPTIONAL_FORMAT_LITE_HPP
+
+#include "nonstd/optional.hpp"
+
+#if optional_CPP17_OR_GREATER && defined( __has_include )
+# if __has_include( <charconv> )
+#  define optional_HAVE_CHARCONV  1
+# endif
+#endif
+
+#ifndef optional_HAVE_CHARCONV
+# define optional_HAVE_CHARCONV  0
+#endif
+
+#if optional_HAVE_CHARCONV
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+// Floating-point std::to_chars() and std::from_chars() are a later addition
+// to some standard libraries:
+
+#if defined( __cpp_lib_to_chars ) || ( defined( _MSC_VER ) && _MSC_VER >= 1924 )
+# define optional_HAVE_CHARCONV_FLOAT  1
+#else
+# define optional_HAVE_CHARCONV_FLOAT  0
+#endif
+
+#if optional_CPP20_OR_GREATER && defined( __has_include )
+# if __has_include( <format> )
+#  include <format>
+# endif
+#endif
+
+#if defined( __cpp_lib_format ) && !optional_USES_STD_OPTIONAL
+# define optional_USES_STD_FORMAT  1
+#else
+# define optional_USES_STD_FORMAT  0
+#endif
+
+//
+// Text conversion of optional<T>, T arithmetic other than bool, without
+// allocation:
+//
+// to_chars() writes the value as std::to_chars() does, or the null token for
+// an empty optional. from_chars() reads the null token as an empty optional,
+// or a value as std::from_chars() does. The null token defaults to "null".
+//
+// With C++20 <format>, std::formatter<nonstd::optional<T>> formats the value
+// as T, or the null token. A format spec may start with a null token between
+// single quotes, followed by the spec for T, as in "{:'-'>8}"; the null token
+// is written as is, the spec applies to the value only. The same holds
+// for fmt::formatter, if {fmt} is included before this header.
+//
+
+namespace nonstd { namespace optional_lite {
+
+namespace detail {
+
+template< typename T >
+using charconv_t = typename std::enable_if<
+    std::is_arithmetic<T>::value && !std::is_same<T, bool>::value
+#if !optional_HAVE_CHARCONV_FLOAT
+    && !std::is_floating_point<T>::value
+#endif
+    , std::nullptr_t >::type;
+
+char const * const default_null_token = "null";
+
+} // namespace detail
+
+/// write the value of x or null_token to [first, last); args as std::to_chars():
+
+template< typename T, typename... Args, detail::charconv_t<T> = nullptr >
+std::to_chars_result to_chars( char * first, char * last, optional<T> const & x, char const * null_token, Args... args )
+{
+    if ( x.has_value() )
+    {
+        return std::to_chars( first, last, *x, args... );
+    }
+
+    std::size_t const length = std::strlen( null_token );
+
+    if ( static_cast<std::size_t>( last - first ) < length )
+    {
+        return { last, std::errc::value_too_large };
+    }
+
+    std::memcpy( first, null_token, length );
+    return { first + length, std::errc() };
+}
+
+template< typename T, detail::charconv_t<T> = nullptr >
+std::to_chars_result to_chars( char * first, char * last, optional<T> const & x )
+{
+    return to_chars( first, last, x, detail::default_null_token );
+}
+
+/// read null_token as nullopt, or a value as std::from_chars(), into x;
+/// x is unchanged on error:
+
+template< typename T, typename... Args, detail::charconv_t<T> = nullptr >
+std::from_chars_result from_chars( char const * first, char const * last, optional<T> & x, char const * null_token, Args... args )
+{
+    std::size_t const length = std::strlen( null_token );
+
+    if ( static_cast<std::size_t>( last - first ) >= length
+        && std::memcmp( first, null_token, length ) == 0
+        && ( length > 0 || first == last ) )
+    {
+        x = nullopt;
+        return { first + length, std::errc() };
+    }
+
+    T value{};
+    std::from_chars_result const result = std::from_chars( first, last, value, args... );
+
+    if ( result.ec == std::errc() )
+    {
+        x = value;
+    }
+    return result;
+}
+
+template< typename T, detail::charconv_t<T> = nullptr >
+std::from_chars_result from_chars( char const * first, char const * last, optional<T> & x )
+{
+    return from_chars( first, last, x, detail::default_null_token );
+}
+
+namespace detail {
+
+// split a format spec "'null-token'spec" into null and the rest of the spec:
+
+template< typename Iterator, typename Error >
+Iterator parse_null_token( Iterator first, Iterator last, std::string_view & null )
+{
+    if ( first == last || *first != '\'' )
+    {
+        return first;
+    }
+
+    Iterator const begin = ++first;
+
+    while ( first != last && *first != '\'' )
+    {
+        ++first;
+    }
+
+    if ( first == last )
+    {
+        throw Error( "missing closing quote of null token in format spec of optional" );
+    }
+
+    null = std::string_view( begin == first ? "" : &*begin, static_cast<std::size_t>( first - begin ) );
+    return ++first;
+}
+
+} // namespace detail
+
+}} // namespace nonstd::optional_lite
+
+namespace nonstd {
+
+using optional_lite::to_chars;
+using optional_lite::from_chars;
+
+} // namespace nonstd
+
+#if optional_USES_STD_FORMAT
+
+template< typename T >
+struct std::formatter< nonstd::optional<T>, char >
+{
+    constexpr auto parse( std::format_parse_context & ctx )
+    {
+        ctx.advance_to( nonstd::optional_lite::detail::parse_null_token<
+            std::format_parse_context::iterator, std::format_error >( ctx.begin(), ctx.end(), null_ ) );
+
+        return value_.parse( ctx );
+    }
+
+    template< typename FormatContext >
+    auto format( nonstd::optional<T> const & x, FormatContext & ctx ) const
+    {
+        if ( !x.has_value() )
+        {
+            return std::copy( null_.begin(), null_.end(), ctx.out() );
+        }
+        return value_.format( *x, ctx );
+    }
+
+private:
+    std::formatter<T, char> value_;
+    std::string_view null_ = nonstd::optional_lite::detail::default_null_token;
+};
+
+#endif // optional_USES_STD_FORMAT
+
+#if defined( FMT_VERSION ) && !optional_USES_STD_OPTIONAL
+
+template< typename T >
+struct fmt::formatter< nonstd::optional<T>, char >
+{
+    template< typename ParseContext >
+    constexpr auto parse( ParseContext & ctx ) -> decltype( ctx.begin() )
+    {
+        ctx.advance_to( nonstd::optional_lite::detail::parse_null_token<
+            decltype( ctx.begin() ), fmt::format_error >( ctx.begin(), ctx.end(), null_ ) );
+
+        return value_.parse( ctx );
+    }
+
+    template< typename FormatContext >
+    auto format( nonstd::optional<T> const & x, FormatContext & ctx ) const -> decltype( ctx.out() )
+    {
+        if ( !x.has_value() )
+        {
+            return std::copy( null_.begin(), null_.end(), ctx.out() );
+        }
+        return value_.format( *x, ctx );
+    }
+
+private:
+    fmt::formatter<T, char> value_;
+    std::string_view null_ = nonstd::optional_lite::detail::default_null_token;
+};
+
+#endif // FMT_VERSION
+
+#endif // optional_HAVE_CHARCONV
+
+#endif // NONSTD_OPTIONAL_FORMAT_LITE_HPP
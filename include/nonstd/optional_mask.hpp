@@ -0,0 +1,198 @@
+//
+// Copyright (c) 2026 Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#ifndef NONSTD_OPTIONAL_MASK_LITE_HPP
+#define NONSTD_OPTIONAL_MASK_LITE_HPP
+
+#include "nonstd/optional.hpp"
+#include "nonstd/optional_bits.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+//
+// Engagement masks of random-access ranges of optionals:
+//
+// The has_value() flags of 64 consecutive optionals are gathered into bytes
+// without branches, a loop that compilers vectorize, and the bytes are packed
+// into one 64-bit word eight at a time by a multiplication. Scans then
+// visit the set bits of each word by counting trailing zeros, and counts add
+// the population count of each word, so that the cost of a sparse scan is
+// one branch per engaged element rather than one per element.
+//
+
+namespace nonstd { namespace optional_lite {
+
+namespace detail {
+
+// Number of trailing zero bits of a non-zero 64-bit word:
+
+inline int ctz64( std::uint64_t x ) noexcept
+{
+    assert( x != 0 );
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll( x );
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64( &index, x );
+    return static_cast<int>( index );
+#else
+    return popcount64( ( x & ( 0 - x ) ) - 1 );
+#endif
+}
+
+// pack 8 bytes of value 0 or 1 into the low 8 bits, byte j into bit j:
+
+inline std::uint64_t pack_bytes( unsigned char const * p ) noexcept
+{
+    std::uint64_t bytes;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ || defined(_MSC_VER)
+    std::memcpy( &bytes, p, sizeof( bytes ) );
+#else
+    bytes = 0;
+    for ( int j = 0; j < 8; ++j )
+    {
+        bytes |= std::uint64_t( p[j] ) << ( 8 * j );
+    }
+#endif
+    return ( bytes * 0x0102040810204080ull ) >> 56;
+}
+
+// bit j set for engaged first[j], j < n <= 64:
+
+template< typename Iterator >
+std::uint64_t engaged_word( Iterator first, std::size_t n )
+{
+    typedef typename std::iterator_traits<Iterator>::difference_type difference_type;
+
+    std::uint64_t word = 0;
+
+    if ( n == 64 )
+    {
+        unsigned char flags[ 64 ];
+
+        for ( std::size_t j = 0; j < 64; ++j )
+        {
+            flags[j] = first[ static_cast<difference_type>( j ) ].has_value();
+        }
+        for ( std::size_t k = 0; k < 8; ++k )
+        {
+            word |= pack_bytes( flags + 8 * k ) << ( 8 * k );
+        }
+    }
+    else
+    {
+        for ( std::size_t j = 0; j < n; ++j )
+        {
+            word |= std::uint64_t( first[ static_cast<difference_type>( j ) ].has_value() ) << j;
+        }
+    }
+    return word;
+}
+
+// call f( i, word ) for the engagement word of elements [i, i + 64):
+
+template< typename Iterator, typename F >
+void for_each_engaged_word( Iterator first, Iterator last, F f )
+{
+    std::size_t const n = static_cast<std::size_t>( last - first );
+
+    for ( std::size_t i = 0; i < n; i += 64 )
+    {
+        std::size_t const m = n - i < 64 ? n - i : 64;
+
+        f( i, engaged_word( first + static_cast<typename std::iterator_traits<Iterator>::difference_type>( i ), m ) );
+    }
+}
+
+} // namespace detail
+
+/// bitmap of the engaged optionals of [first, last): bit i % 64 of word i / 64
+/// is set if first[i] is engaged; bits beyond the range are zero:
+
+template< typename Iterator >
+std::vector<std::uint64_t> engaged_mask( Iterator first, Iterator last )
+{
+    std::vector<std::uint64_t> mask;
+    mask.reserve( ( static_cast<std::size_t>( last - first ) + 63 ) / 64 );
+
+    detail::for_each_engaged_word( first, last, [&]( std::size_t, std::uint64_t word )
+    {
+        mask.push_back( word );
+    } );
+    return mask;
+}
+
+template< typename Range >
+std::vector<std::uint64_t> engaged_mask( Range const & r )
+{
+    return engaged_mask( std::begin( r ), std::end( r ) );
+}
+
+/// the number of engaged optionals of [first, last):
+
+template< typename Iterator >
+std::size_t count_engaged( Iterator first, Iterator last )
+{
+    std::size_t count = 0;
+
+    detail::for_each_engaged_word( first, last, [&]( std::size_t, std::uint64_t word )
+    {
+        count += static_cast<std::size_t>( detail::popcount64( word ) );
+    } );
+    return count;
+}
+
+template< typename Range >
+std::size_t count_engaged( Range const & r )
+{
+    return count_engaged( std::begin( r ), std::end( r ) );
+}
+
+/// call f( *x ) for each engaged optional x of [first, last), in order:
+
+template< typename Iterator, typename F >
+F for_each_engaged( Iterator first, Iterator last, F f )
+{
+    detail::for_each_engaged_word( first, last, [&]( std::size_t i, std::uint64_t word )
+    {
+        for ( ; word != 0; word &= word - 1 )
+        {
+            f( *first[ static_cast<typename std::iterator_traits<Iterator>::difference_type>( i + static_cast<std::size_t>( detail::ctz64( word ) ) ) ] );
+        }
+    } );
+    return f;
+}
+
+template< typename Range, typename F >
+F for_each_engaged( Range && r, F f )
+{
+    return for_each_engaged( std::begin( r ), std::end( r ), f );
+}
+
+}} // namespace nonstd::optional_lite
+
+namespace nonstd {
+
+using optional_lite::engaged_mask;
+using optional_lite::count_engaged;
+using optional_lite::for_each_engaged;
+
+} // namespace nonstd
+
+#endif // optional_CPP11_OR_GREATER
+
+#endif // NONSTD_OPTIONAL_MASK_LITE_HPP
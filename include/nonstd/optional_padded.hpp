@@ -0,0 +1,194 @@
+//
+// Copyright (c) 2026 Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#ifndef NONSTD_OPTIONAL_PADDED_LITE_HPP
+#define NONSTD_OPTIONAL_PADDED_LITE_HPP
+
+#include "nonstd/optional.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+
+// Alignment of padded_optional: a fixed 64 rather than
+// std::hardware_destructive_interference_size, which may differ between
+// compiler options and therefore between translation units:
+
+#ifndef  optional_CONFIG_CACHE_LINE_SIZE
+# define optional_CONFIG_CACHE_LINE_SIZE  64
+#endif
+
+namespace nonstd { namespace optional_lite {
+
+/// class padded_optional
+///
+/// An optional<T> that occupies whole cache lines of its own, so that
+/// threads that write neighbouring padded_optionals do not share a line.
+
+template< typename T >
+class alignas( optional_CONFIG_CACHE_LINE_SIZE ) padded_optional : public optional<T>
+{
+public:
+    using optional<T>::optional;
+
+    padded_optional() = default;
+
+    padded_optional( optional<T> const & other )
+    : optional<T>( other )
+    {}
+
+    padded_optional( optional<T> && other )
+    : optional<T>( std::move( other ) )
+    {}
+
+    template< typename U >
+    padded_optional & operator=( U && other )
+    {
+        optional<T>::operator=( std::forward<U>( other ) );
+        return *this;
+    }
+};
+
+/// class per_thread_optional
+///
+/// A fixed number of padded_optional<T> slots, one per thread, that threads
+/// write without synchronization, and that are combined afterwards. Allocates
+/// its slots aligned also where operator new does not honour alignas.
+
+template< typename T >
+class per_thread_optional
+{
+public:
+    typedef padded_optional<T>  value_type;
+    typedef std::size_t         size_type;
+    typedef value_type *        iterator;
+    typedef value_type const *  const_iterator;
+
+    // one slot per hardware thread, or n slots:
+
+    explicit per_thread_optional( size_type n = 0 )
+    : size_( n ? n : (std::max)( 1u, std::thread::hardware_concurrency() ) )
+    , raw_( new unsigned char[ size_ * sizeof( value_type ) + alignof( value_type ) - 1 ] )
+    {
+        void * p = raw_.get();
+        std::size_t space = size_ * sizeof( value_type ) + alignof( value_type ) - 1;
+
+        slots_ = static_cast<value_type *>( std::align( alignof( value_type ), size_ * sizeof( value_type ), p, space ) );
+
+        for ( size_type i = 0; i < size_; ++i )
+        {
+            ::new( static_cast<void *>( slots_ + i ) ) value_type();
+        }
+    }
+
+    per_thread_optional( per_thread_optional const & ) = delete;
+    per_thread_optional & operator=( per_thread_optional const & ) = delete;
+
+    ~per_thread_optional()
+    {
+        for ( size_type i = 0; i < size_; ++i )
+        {
+            slots_[i].~value_type();
+        }
+    }
+
+    size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    value_type & operator[]( size_type i ) noexcept
+    {
+        return assert( i < size_ ), slots_[i];
+    }
+
+    value_type const & operator[]( size_type i ) const noexcept
+    {
+        return assert( i < size_ ), slots_[i];
+    }
+
+    iterator       begin()       noexcept { return slots_; }
+    iterator       end()         noexcept { return slots_ + size_; }
+    const_iterator begin() const noexcept { return slots_; }
+    const_iterator end()   const noexcept { return slots_ + size_; }
+
+    void reset() noexcept
+    {
+        for ( auto & slot : *this )
+        {
+            slot.reset();
+        }
+    }
+
+    size_type count_engaged() const noexcept
+    {
+        size_type count = 0;
+        for ( auto const & slot : *this )
+        {
+            count += slot.has_value();
+        }
+        return count;
+    }
+
+    // the engaged values combined by f( T, T ) in slot order, nullopt if none:
+
+    template< typename F >
+    optional<T> combine( F f ) const
+    {
+        optional<T> result;
+        for ( auto const & slot : *this )
+        {
+            if ( slot.has_value() )
+            {
+                result = result.has_value() ? optional<T>( f( *result, *slot ) ) : optional<T>( *slot );
+            }
+        }
+        return result;
+    }
+
+    // init and the engaged values folded by f( U, T ) in slot order:
+
+    template< typename U, typename F >
+    U reduce( U init, F f ) const
+    {
+        for ( auto const & slot : *this )
+        {
+            if ( slot.has_value() )
+            {
+                init = f( std::move( init ), *slot );
+            }
+        }
+        return init;
+    }
+
+private:
+    size_type size_;
+    std::unique_ptr<unsigned char[]> raw_;
+    value_type * slots_;
+};
+
+}} // namespace nonstd::optional_lite
+
+namespace nonstd {
+
+using optional_lite::padded_optional;
+using optional_lite::per_thread_optional;
+
+} // namespace nonstd
+
+#endif // optional_CPP11_OR_GREATER
+
+#endif // NONSTD_OPTIONAL_PADDED_LITE_HPP
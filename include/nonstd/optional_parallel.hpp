@@ -0,0 +1,389 @@
+//
+// Copyright (c) 2026 Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#ifndef NONSTD_OPTIONAL_PARALLEL_LITE_HPP
+#define NONSTD_OPTIONAL_PARALLEL_LITE_HPP
+
+#include "nonstd/optional.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//
+// Parallel algorithms over random-access ranges of optionals:
+//
+// The range is cut into chunks of a fixed number of elements that span whole
+// cache lines, independent of the number of threads. Threads repeatedly take
+// the next unprocessed chunk, so that a slow thread takes fewer chunks. Sums
+// add the values of a chunk pairwise and then the chunk sums pairwise, so the
+// result is the same for any number of threads.
+//
+// threads == 0 uses std::thread::hardware_concurrency() threads, including
+// the calling thread. An exception thrown on a thread stops the remaining
+// chunks and is rethrown on the calling thread. With optional_CONFIG_NO_EXCEPTIONS,
+// the threads just run all chunks and are joined.
+//
+
+namespace nonstd { namespace optional_lite {
+
+namespace parallel {
+
+namespace detail {
+
+std::size_t const cache_line = 64;
+std::size_t const chunk_bytes = 64 * 1024;
+
+inline std::size_t gcd( std::size_t a, std::size_t b )
+{
+    return b == 0 ? a : gcd( b, a % b );
+}
+
+// elements per chunk: about chunk_bytes, a multiple of whole cache lines:
+
+template< typename T >
+std::size_t chunk_size()
+{
+    std::size_t const line = cache_line / gcd( sizeof( T ), cache_line );
+    std::size_t const target = chunk_bytes / sizeof( T );
+
+    return (std::max)( line, target / line * line );
+}
+
+inline unsigned thread_count( unsigned threads )
+{
+    if ( threads == 0 )
+    {
+        threads = std::thread::hardware_concurrency();
+    }
+    return threads == 0 ? 1 : threads;
+}
+
+template< typename Iterator >
+auto at( Iterator first, std::size_t i ) -> decltype( *first )
+{
+    return first[ static_cast<typename std::iterator_traits<Iterator>::difference_type>( i ) ];
+}
+
+// call f( chunk, first, last ) for every chunk of [0, n):
+
+template< typename F >
+void for_each_chunk( std::size_t n, std::size_t chunk, unsigned threads, F f )
+{
+    std::size_t const chunks = ( n + chunk - 1 ) / chunk;
+    std::size_t const workers = (std::min)( static_cast<std::size_t>( thread_count( threads ) ), chunks );
+
+    if ( workers <= 1 )
+    {
+        for ( std::size_t c = 0; c < chunks; ++c )
+        {
+            f( c, c * chunk, (std::min)( n, ( c + 1 ) * chunk ) );
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next( 0 );
+    std::atomic<bool> failed( false );
+#if !optional_CONFIG_NO_EXCEPTIONS
+    std::exception_ptr error;
+#endif
+
+    auto work = [&]()
+    {
+        for ( ;; )
+        {
+            std::size_t const c = next.fetch_add( 1, std::memory_order_relaxed );
+
+            if ( c >= chunks || failed.load( std::memory_order_relaxed ) )
+            {
+                return;
+            }
+#if optional_CONFIG_NO_EXCEPTIONS
+            f( c, c * chunk, (std::min)( n, ( c + 1 ) * chunk ) );
+#else
+            try
+            {
+                f( c, c * chunk, (std::min)( n, ( c + 1 ) * chunk ) );
+            }
+            catch ( ... )
+            {
+                if ( !failed.exchange( true ) )
+                {
+                    error = std::current_exception();
+                }
+                return;
+            }
+#endif
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve( workers - 1 );
+
+#if optional_CONFIG_NO_EXCEPTIONS
+    for ( std::size_t t = 1; t < workers; ++t )
+    {
+        pool.emplace_back( work );
+    }
+#else
+    // if a thread cannot be started, stop and join the ones already running:
+
+    try
+    {
+        for ( std::size_t t = 1; t < workers; ++t )
+        {
+            pool.emplace_back( work );
+        }
+    }
+    catch ( ... )
+    {
+        failed.store( true );
+
+        for ( auto & thread : pool )
+        {
+            thread.join();
+        }
+        throw;
+    }
+#endif
+
+    work();
+
+    for ( auto & thread : pool )
+    {
+        thread.join();
+    }
+
+#if !optional_CONFIG_NO_EXCEPTIONS
+    if ( error )
+    {
+        std::rethrow_exception( error );
+    }
+#endif
+}
+
+// pairwise sum of the engaged values of first[lo, hi):
+
+template< typename T, typename Iterator >
+T pairwise_sum( Iterator first, std::size_t lo, std::size_t hi )
+{
+    if ( hi - lo <= 8 )
+    {
+        T sum = T();
+        for ( std::size_t i = lo; i < hi; ++i )
+        {
+            if ( at( first, i ).has_value() )
+            {
+                sum += *at( first, i );
+            }
+        }
+        return sum;
+    }
+
+    std::size_t const mid = lo + ( hi - lo ) / 2;
+
+    return pairwise_sum<T>( first, lo, mid ) + pairwise_sum<T>( first, mid, hi );
+}
+
+// pairwise sum of the chunk sums v[lo, hi):
+
+template< typename T >
+T pairwise_sum( std::vector<T> const & v, std::size_t lo, std::size_t hi )
+{
+    if ( hi - lo == 1 )
+    {
+        return v[lo];
+    }
+
+    std::size_t const mid = lo + ( hi - lo ) / 2;
+
+    return pairwise_sum( v, lo, mid ) + pairwise_sum( v, mid, hi );
+}
+
+template< typename Iterator >
+using value_t = typename std::decay< decltype( **std::declval<Iterator>() ) >::type;
+
+// the engaged value of [lo, hi) that is preferred by before( a, b ), if any:
+
+template< typename Iterator, typename Before >
+optional< value_t<Iterator> > select( Iterator first, Iterator last, unsigned threads, Before before )
+{
+    typedef value_t<Iterator> T;
+
+    std::size_t const n = static_cast<std::size_t>( last - first );
+    std::size_t const chunk = chunk_size< typename std::iterator_traits<Iterator>::value_type >();
+    std::vector< optional<T> > best( ( n + chunk - 1 ) / chunk );
+
+    for_each_chunk( n, chunk, threads, [&]( std::size_t c, std::size_t lo, std::size_t hi )
+    {
+        optional<T> result;
+        for ( std::size_t i = lo; i < hi; ++i )
+        {
+            if ( at( first, i ).has_value() && ( !result || before( *at( first, i ), *result ) ) )
+            {
+                result = *at( first, i );
+            }
+        }
+        best[c] = result;
+    } );
+
+    optional<T> result;
+    for ( auto const & b : best )
+    {
+        if ( b && ( !result || before( *b, *result ) ) )
+        {
+            result = b;
+        }
+    }
+    return result;
+}
+
+// assign f( x ) to o; in place via emplace_with() where optional provides it:
+
+template< typename Optional, typename F, typename X >
+auto assign_result( Optional & o, F & f, X && x, int ) -> decltype( void( o.emplace_with( f, std::forward<X>( x ) ) ) )
+{
+    o.emplace_with( f, std::forward<X>( x ) );
+}
+
+template< typename Optional, typename F, typename X >
+void assign_result( Optional & o, F & f, X && x, long )
+{
+    o = f( std::forward<X>( x ) );
+}
+
+} // namespace detail
+
+/// the number of engaged optionals in [first, last):
+
+template< typename Iterator >
+std::size_t count_engaged( Iterator first, Iterator last, unsigned threads = 0 )
+{
+    std::size_t const n = static_cast<std::size_t>( last - first );
+    std::size_t const chunk = detail::chunk_size< typename std::iterator_traits<Iterator>::value_type >();
+    std::atomic<std::size_t> count( 0 );
+
+    detail::for_each_chunk( n, chunk, threads, [&]( std::size_t, std::size_t lo, std::size_t hi )
+    {
+        std::size_t local = 0;
+        for ( std::size_t i = lo; i < hi; ++i )
+        {
+            local += detail::at( first, i ).has_value();
+        }
+        count.fetch_add( local, std::memory_order_relaxed );
+    } );
+
+    return count.load();
+}
+
+/// the sum of the engaged values in [first, last), T() if there are none;
+/// deterministic for floating point, independent of the number of threads:
+
+template< typename Iterator >
+detail::value_t<Iterator> sum_engaged( Iterator first, Iterator last, unsigned threads = 0 )
+{
+    typedef detail::value_t<Iterator> T;
+
+    std::size_t const n = static_cast<std::size_t>( last - first );
+    std::size_t const chunk = detail::chunk_size< typename std::iterator_traits<Iterator>::value_type >();
+    std::vector<T> sums( ( n + chunk - 1 ) / chunk );
+
+    if ( sums.empty() )
+    {
+        return T();
+    }
+
+    detail::for_each_chunk( n, chunk, threads, [&]( std::size_t c, std::size_t lo, std::size_t hi )
+    {
+        sums[c] = detail::pairwise_sum<T>( first, lo, hi );
+    } );
+
+    return detail::pairwise_sum( sums, 0, sums.size() );
+}
+
+/// the least engaged value in [first, last), if any:
+
+template< typename Iterator >
+optional< detail::value_t<Iterator> > min_engaged( Iterator first, Iterator last, unsigned threads = 0 )
+{
+    typedef detail::value_t<Iterator> T;
+    return detail::select( first, last, threads, []( T const & a, T const & b ) { return a < b; } );
+}
+
+/// the greatest engaged value in [first, last), if any:
+
+template< typename Iterator >
+optional< detail::value_t<Iterator> > max_engaged( Iterator first, Iterator last, unsigned threads = 0 )
+{
+    typedef detail::value_t<Iterator> T;
+    return detail::select( first, last, threads, []( T const & a, T const & b ) { return b < a; } );
+}
+
+/// assign f( *x ) to the output for each engaged x in [first, last), nullopt for each empty x:
+
+template< typename Iterator, typename OutputIterator, typename F >
+OutputIterator transform_engaged( Iterator first, Iterator last, OutputIterator result, F f, unsigned threads = 0 )
+{
+    std::size_t const n = static_cast<std::size_t>( last - first );
+    std::size_t const chunk = detail::chunk_size< typename std::iterator_traits<OutputIterator>::value_type >();
+
+    detail::for_each_chunk( n, chunk, threads, [&]( std::size_t, std::size_t lo, std::size_t hi )
+    {
+        for ( std::size_t i = lo; i < hi; ++i )
+        {
+            if ( detail::at( first, i ).has_value() ) detail::assign_result( detail::at( result, i ), f, *detail::at( first, i ), 0 );
+            else                        detail::at( result, i ) = nullopt;
+        }
+    } );
+
+    return result + static_cast<typename std::iterator_traits<OutputIterator>::difference_type>( n );
+}
+
+/// assign value to each empty optional in [first, last):
+
+template< typename Iterator, typename U >
+void fill_empty( Iterator first, Iterator last, U const & value, unsigned threads = 0 )
+{
+    std::size_t const n = static_cast<std::size_t>( last - first );
+    std::size_t const chunk = detail::chunk_size< typename std::iterator_traits<Iterator>::value_type >();
+
+    detail::for_each_chunk( n, chunk, threads, [&]( std::size_t, std::size_t lo, std::size_t hi )
+    {
+        for ( std::size_t i = lo; i < hi; ++i )
+        {
+            if ( !detail::at( first, i ).has_value() )
+            {
+                detail::at( first, i ) = value;
+            }
+        }
+    } );
+}
+
+} // namespace parallel
+
+}} // namespace nonstd::optional_lite
+
+namespace nonstd {
+
+namespace parallel = optional_lite::parallel;
+
+} // namespace nonstd
+
+#endif // optional_CPP11_OR_GREATER
+
+#endif // NONSTD_OPTIONAL_PARALLEL_LITE_HPP
@@ -0,0 +1,368 @@
+//
+// Copyright (c) 2026 Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#ifndef NONSTD_OPTIONAL_RANGES_LITE_HPP
+#define NONSTD_OPTIONAL_RANGES_LITE_HPP
+
+#include "nonstd/optional.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#if optional_CPP20_OR_GREATER
+# include <version>
+#endif
+
+// With C++20 ranges, the views are range adaptor closures of std::views:
+
+#if defined( __cpp_lib_ranges )
+# define optional_USES_STD_RANGES  1
+# include <ranges>
+#else
+# define optional_USES_STD_RANGES  0
+#endif
+
+//
+// Lazy views over a range of optionals, in a single pass without intermediate storage:
+//
+// - views::engaged( r ): the engaged optionals of r,
+// - views::values( r ): the values of the engaged optionals of r,
+// - views::values_or( r, x ): the value of each optional of r, or x if it is empty.
+//
+// With C++20 ranges, also r | views::engaged, r | views::values and r | views::values_or( x ).
+//
+
+namespace nonstd { namespace optional_lite {
+
+namespace detail {
+
+// the value of an optional; by value if the optional is a temporary:
+
+struct deref
+{
+    template< typename O >
+    auto operator()( O && o ) const -> typename std::conditional<
+        std::is_lvalue_reference<O>::value, decltype( *o ), typename std::decay<decltype( *o )>::type >::type
+    {
+        return *std::forward<O>( o );
+    }
+};
+
+struct is_engaged
+{
+    template< typename O >
+    bool operator()( O const & o ) const
+    {
+        return o.has_value();
+    }
+};
+
+template< typename U >
+struct value_or_fn
+{
+    U default_value;
+
+    template< typename O >
+    auto operator()( O && o ) const -> typename std::decay<decltype( *o )>::type
+    {
+        return std::forward<O>( o ).value_or( default_value );
+    }
+};
+
+template< typename Iterator >
+using iter_ref_t = typename std::iterator_traits<Iterator>::reference;
+
+} // namespace detail
+
+// iterator over the engaged optionals of [first, last):
+
+template< typename Iterator >
+class engaged_iterator
+{
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+    typedef typename std::iterator_traits<Iterator>::difference_type difference_type;
+    typedef typename std::iterator_traits<Iterator>::pointer pointer;
+    typedef typename std::iterator_traits<Iterator>::reference reference;
+
+    engaged_iterator() = default;
+
+    engaged_iterator( Iterator first, Iterator last )
+    : it_( first ), last_( last )
+    {
+        skip();
+    }
+
+    reference operator*() const
+    {
+        return *it_;
+    }
+
+    engaged_iterator & operator++()
+    {
+        ++it_;
+        skip();
+        return *this;
+    }
+
+    engaged_iterator operator++( int )
+    {
+        engaged_iterator tmp( *this );
+        ++*this;
+        return tmp;
+    }
+
+    Iterator base() const
+    {
+        return it_;
+    }
+
+    friend bool operator==( engaged_iterator const & a, engaged_iterator const & b )
+    {
+        return a.it_ == b.it_;
+    }
+
+    friend bool operator!=( engaged_iterator const & a, engaged_iterator const & b )
+    {
+        return !( a == b );
+    }
+
+private:
+    void skip()
+    {
+        while ( it_ != last_ && !detail::is_engaged()( *it_ ) )
+        {
+            ++it_;
+        }
+    }
+
+    Iterator it_   = Iterator();
+    Iterator last_ = Iterator();
+};
+
+// iterator over the values of the engaged optionals of [first, last):
+
+template< typename Iterator >
+class values_iterator
+{
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef decltype( detail::deref()( std::declval< detail::iter_ref_t<Iterator> >() ) ) reference;
+    typedef typename std::decay<reference>::type value_type;
+    typedef typename std::iterator_traits<Iterator>::difference_type difference_type;
+    typedef typename std::remove_reference<reference>::type * pointer;
+
+    values_iterator() = default;
+
+    values_iterator( Iterator first, Iterator last )
+    : it_( first, last ) {}
+
+    reference operator*() const
+    {
+        return detail::deref()( *it_ );
+    }
+
+    values_iterator & operator++()
+    {
+        ++it_;
+        return *this;
+    }
+
+    values_iterator operator++( int )
+    {
+        values_iterator tmp( *this );
+        ++*this;
+        return tmp;
+    }
+
+    Iterator base() const
+    {
+        return it_.base();
+    }
+
+    friend bool operator==( values_iterator const & a, values_iterator const & b )
+    {
+        return a.it_ == b.it_;
+    }
+
+    friend bool operator!=( values_iterator const & a, values_iterator const & b )
+    {
+        return !( a == b );
+    }
+
+private:
+    engaged_iterator<Iterator> it_;
+};
+
+// iterator over the value, or a default, of each optional of [first, last):
+
+template< typename Iterator, typename U >
+class values_or_iterator
+{
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef decltype( std::declval< detail::value_or_fn<U> const & >()( std::declval< detail::iter_ref_t<Iterator> >() ) ) value_type;
+    typedef value_type reference;
+    typedef typename std::iterator_traits<Iterator>::difference_type difference_type;
+    typedef value_type const * pointer;
+
+    values_or_iterator() = default;
+
+    values_or_iterator( Iterator it, U const & default_value )
+    : it_( it ), fn_{ default_value } {}
+
+    reference operator*() const
+    {
+        return fn_( *it_ );
+    }
+
+    values_or_iterator & operator++()
+    {
+        ++it_;
+        return *this;
+    }
+
+    values_or_iterator operator++( int )
+    {
+        values_or_iterator tmp( *this );
+        ++*this;
+        return tmp;
+    }
+
+    Iterator base() const
+    {
+        return it_;
+    }
+
+    friend bool operator==( values_or_iterator const & a, values_or_iterator const & b )
+    {
+        return a.it_ == b.it_;
+    }
+
+    friend bool operator!=( values_or_iterator const & a, values_or_iterator const & b )
+    {
+        return !( a == b );
+    }
+
+private:
+    Iterator it_ = Iterator();
+    detail::value_or_fn<U> fn_ = detail::value_or_fn<U>();
+};
+
+// a pair of iterators usable in a range-based for:
+
+template< typename Iterator >
+class iterator_range
+{
+public:
+    typedef Iterator iterator;
+
+    iterator_range( Iterator first, Iterator last )
+    : first_( first ), last_( last ) {}
+
+    Iterator begin() const
+    {
+        return first_;
+    }
+
+    Iterator end() const
+    {
+        return last_;
+    }
+
+    bool empty() const
+    {
+        return first_ == last_;
+    }
+
+private:
+    Iterator first_;
+    Iterator last_;
+};
+
+namespace detail {
+
+template< typename Range >
+using range_iterator_t = decltype( std::begin( std::declval<Range &>() ) );
+
+} // namespace detail
+
+}} // namespace nonstd::optional_lite
+
+namespace nonstd {
+
+using optional_lite::engaged_iterator;
+using optional_lite::values_iterator;
+using optional_lite::values_or_iterator;
+using optional_lite::iterator_range;
+
+namespace views {
+
+#if optional_USES_STD_RANGES
+
+inline constexpr auto engaged = std::views::filter( optional_lite::detail::is_engaged() );
+
+inline constexpr auto values  = engaged | std::views::transform( optional_lite::detail::deref() );
+
+struct values_or_fn
+{
+    template< typename U >
+    constexpr auto operator()( U && default_value ) const
+    {
+        return std::views::transform( optional_lite::detail::value_or_fn< std::decay_t<U> >{ std::forward<U>( default_value ) } );
+    }
+
+    template< std::ranges::viewable_range Range, typename U >
+    constexpr auto operator()( Range && r, U && default_value ) const
+    {
+        return std::forward<Range>( r ) | ( *this )( std::forward<U>( default_value ) );
+    }
+};
+
+inline constexpr values_or_fn values_or{};
+
+#else // optional_USES_STD_RANGES
+
+template< typename Range >
+iterator_range< engaged_iterator< optional_lite::detail::range_iterator_t<Range> > >
+engaged( Range & r )
+{
+    typedef engaged_iterator< optional_lite::detail::range_iterator_t<Range> > iterator;
+    return { iterator( std::begin( r ), std::end( r ) ), iterator( std::end( r ), std::end( r ) ) };
+}
+
+template< typename Range >
+iterator_range< values_iterator< optional_lite::detail::range_iterator_t<Range> > >
+values( Range & r )
+{
+    typedef values_iterator< optional_lite::detail::range_iterator_t<Range> > iterator;
+    return { iterator( std::begin( r ), std::end( r ) ), iterator( std::end( r ), std::end( r ) ) };
+}
+
+template< typename Range, typename U >
+iterator_range< values_or_iterator< optional_lite::detail::range_iterator_t<Range>, U > >
+values_or( Range & r, U const & default_value )
+{
+    typedef values_or_iterator< optional_lite::detail::range_iterator_t<Range>, U > iterator;
+    return { iterator( std::begin( r ), default_value ), iterator( std::end( r ), default_value ) };
+}
+
+#endif // optional_USES_STD_RANGES
+
+} // namespace views
+} // namespace nonstd
+
+#endif // optional_CPP11_OR_GREATER
+
+#endif // NONSTD_OPTIONAL_RANGES_LITE_HPP
@@ -0,0 +1,446 @@
+//
+// Copyright (c) 2026 Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#ifndef NONSTD_OPTIONAL_RELOCATE_LITE_HPP
+#define NONSTD_OPTIONAL_RELOCATE_LITE_HPP
+
+#include "nonstd/optional.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//
+// is_trivially_relocatable: code to share with other nonstd lite libraries:
+//
+// A type is trivially relocatable if moving an object to a new address and
+// ending the lifetime of the source is equivalent to copying its bytes.
+// Opt in a type of your own by specializing nonstd::is_trivially_relocatable.
+//
+
+#ifndef nonstd_lite_HAVE_IS_TRIVIALLY_RELOCATABLE
+#define nonstd_lite_HAVE_IS_TRIVIALLY_RELOCATABLE  1
+
+namespace nonstd {
+
+template< typename T >
+struct is_trivially_relocatable : std::integral_constant< bool,
+    std::is_trivially_copyable<T>::value && !std::is_volatile<T>::value >{};
+
+template< typename T >
+struct is_trivially_relocatable< T const > : is_trivially_relocatable<T>{};
+
+// std::unique_ptr with the default deleter holds a single pointer on all
+// major standard library implementations. Note that std::string is not
+// included: libstdc++'s short-string optimization points into the object.
+
+template< typename T >
+struct is_trivially_relocatable< std::unique_ptr<T, std::default_delete<T> > > : std::true_type{};
+
+} // namespace nonstd
+
+#endif // nonstd_lite_HAVE_IS_TRIVIALLY_RELOCATABLE
+
+namespace nonstd {
+
+// An optional is as relocatable as its payload:
+
+template< typename T >
+struct is_trivially_relocatable< optional<T> > : is_trivially_relocatable<T>{};
+
+namespace optional_lite {
+
+namespace detail {
+
+template< typename T >
+T * relocate_at( T * src, T * dst, std::true_type /*trivial*/ ) noexcept
+{
+    std::memcpy( static_cast<void *>( dst ), static_cast<void const *>( src ), sizeof( T ) );
+    return dst;
+}
+
+template< typename T >
+T * relocate_at( T * src, T * dst, std::false_type /*trivial*/ )
+    noexcept( std::is_nothrow_move_constructible<T>::value )
+{
+    ::new( static_cast<void *>( dst ) ) T( std::move( *src ) );
+    src->~T();
+    return dst;
+}
+
+} // namespace detail
+
+/// Move-construct *dst from *src and destroy *src; memcpy if trivially relocatable.
+
+template< typename T >
+T * relocate_at( T * src, T * dst )
+    noexcept( is_trivially_relocatable<T>::value || std::is_nothrow_move_constructible<T>::value )
+{
+    return detail::relocate_at( src, dst, std::integral_constant<bool, is_trivially_relocatable<T>::value>() );
+}
+
+namespace detail {
+
+template< typename T >
+T * uninitialized_relocate( T * first, T * last, T * result, std::true_type /*trivial*/ ) noexcept
+{
+    std::size_t const n = static_cast<std::size_t>( last - first );
+
+    if ( n != 0 )
+    {
+        std::memmove( static_cast<void *>( result ), static_cast<void const *>( first ), n * sizeof( T ) );
+    }
+    return result + n;
+}
+
+template< typename T >
+T * uninitialized_relocate( T * first, T * last, T * result, std::false_type /*trivial*/ )
+{
+    T * out = result;
+#if !optional_CONFIG_NO_EXCEPTIONS
+    try
+#endif
+    {
+        for ( ; first != last; ++first, ++out )
+        {
+            relocate_at( first, out, std::false_type() );
+        }
+    }
+#if !optional_CONFIG_NO_EXCEPTIONS
+    catch ( ... )
+    {
+        for ( T * p = result; p != out; ++p ) p->~T();
+        for ( ; first != last; ++first ) first->~T();
+        throw;
+    }
+#endif
+    return out;
+}
+
+} // namespace detail
+
+/// Relocate [first, last) into uninitialized storage at result; memmove if trivially relocatable.
+/// If relocation of an element throws, the already relocated elements at the
+/// destination and the not yet relocated elements at the source are destroyed.
+
+template< typename T >
+T * uninitialized_relocate( T * first, T * last, T * result )
+    noexcept( is_trivially_relocatable<T>::value || std::is_nothrow_move_constructible<T>::value )
+{
+    return detail::uninitialized_relocate( first, last, result, std::integral_constant<bool, is_trivially_relocatable<T>::value>() );
+}
+
+template< typename T >
+T * uninitialized_relocate_n( T * first, std::size_t n, T * result )
+    noexcept( noexcept( uninitialized_relocate( first, first + n, result ) ) )
+{
+    return uninitialized_relocate( first, first + n, result );
+}
+
+/// class relocating_vector
+///
+/// A minimal growable array that relocates its elements on reallocation.
+/// For a trivially relocatable element type, such as optional<std::unique_ptr<X>>,
+/// growing the array is a single memcpy instead of a move-construction and a
+/// destruction per element. Otherwise it moves if noexcept, else copies, like
+/// std::vector, which retains the strong exception guarantee of push_back.
+
+template< typename T, typename Allocator = std::allocator<T> >
+class relocating_vector
+{
+    typedef std::allocator_traits<Allocator> alloc_traits;
+
+public:
+    typedef T                   value_type;
+    typedef Allocator           allocator_type;
+    typedef std::size_t         size_type;
+    typedef std::ptrdiff_t      difference_type;
+    typedef T &                 reference;
+    typedef T const &           const_reference;
+    typedef T *                 pointer;
+    typedef T const *           const_pointer;
+    typedef T *                 iterator;
+    typedef T const *           const_iterator;
+
+    relocating_vector() noexcept( noexcept( Allocator() ) )
+    : data_( nullptr ), size_( 0 ), capacity_( 0 ), alloc_()
+    {}
+
+    explicit relocating_vector( Allocator const & alloc ) noexcept
+    : data_( nullptr ), size_( 0 ), capacity_( 0 ), alloc_( alloc )
+    {}
+
+    relocating_vector( relocating_vector const & other )
+    : data_( nullptr ), size_( 0 ), capacity_( 0 )
+    , alloc_( alloc_traits::select_on_container_copy_construction( other.alloc_ ) )
+    {
+        reserve( other.size_ );
+        for ( T const & v : other )
+        {
+            emplace_back( v );
+        }
+    }
+
+    relocating_vector( relocating_vector && other ) noexcept
+    : data_( other.data_ ), size_( other.size_ ), capacity_( other.capacity_ ), alloc_( std::move( other.alloc_ ) )
+    {
+        other.data_ = nullptr;
+        other.size_ = other.capacity_ = 0;
+    }
+
+    relocating_vector & operator=( relocating_vector other ) noexcept
+    {
+        swap( other );
+        return *this;
+    }
+
+    ~relocating_vector()
+    {
+        clear();
+        deallocate( data_, capacity_ );
+    }
+
+    // capacity:
+
+    size_type size()     const noexcept { return size_; }
+    size_type capacity() const noexcept { return capacity_; }
+    bool      empty()    const noexcept { return size_ == 0; }
+
+    void reserve( size_type n )
+    {
+        if ( n > capacity_ )
+        {
+            reallocate( n );
+        }
+    }
+
+    void shrink_to_fit()
+    {
+        if ( size_ < capacity_ )
+        {
+            reallocate( size_ );
+        }
+    }
+
+    // element access:
+
+    reference       operator[]( size_type pos )       { assert( pos < size_ ); return data_[pos]; }
+    const_reference operator[]( size_type pos ) const { assert( pos < size_ ); return data_[pos]; }
+
+    reference       front()       { assert( size_ > 0 ); return data_[0]; }
+    const_reference front() const { assert( size_ > 0 ); return data_[0]; }
+    reference       back()        { assert( size_ > 0 ); return data_[size_ - 1]; }
+    const_reference back()  const { assert( size_ > 0 ); return data_[size_ - 1]; }
+
+    pointer       data()       noexcept { return data_; }
+    const_pointer data() const noexcept { return data_; }
+
+    // iterators:
+
+    iterator       begin()        noexcept { return data_; }
+    iterator       end()          noexcept { return data_ + size_; }
+    const_iterator begin()  const noexcept { return data_; }
+    const_iterator end()    const noexcept { return data_ + size_; }
+    const_iterator cbegin() const noexcept { return data_; }
+    const_iterator cend()   const noexcept { return data_ + size_; }
+
+    // modifiers:
+
+    template< typename... Args >
+    reference emplace_back( Args&&... args )
+    {
+        if ( size_ == capacity_ )
+        {
+            grow_and_emplace_back( std::forward<Args>( args )... );
+        }
+        else
+        {
+            alloc_traits::construct( alloc_, data_ + size_, std::forward<Args>( args )... );
+            ++size_;
+        }
+        return back();
+    }
+
+    void push_back( T const & value ) { emplace_back( value ); }
+    void push_back( T && value )      { emplace_back( std::move( value ) ); }
+
+    void pop_back()
+    {
+        assert( size_ > 0 );
+        alloc_traits::destroy( alloc_, data_ + --size_ );
+    }
+
+    void resize( size_type n )
+    {
+        reserve( n );
+        while ( size_ < n ) emplace_back();
+        while ( size_ > n ) pop_back();
+    }
+
+    void clear() noexcept
+    {
+        while ( size_ > 0 ) pop_back();
+    }
+
+    void swap( relocating_vector & other ) noexcept
+    {
+        using std::swap;
+        swap( data_    , other.data_ );
+        swap( size_    , other.size_ );
+        swap( capacity_, other.capacity_ );
+        swap( alloc_   , other.alloc_ );
+    }
+
+private:
+    typedef std::integral_constant<bool, is_trivially_relocatable<T>::value> trivially_relocatable;
+
+    size_type next_capacity() const noexcept
+    {
+        return capacity_ == 0 ? 4 : 2 * capacity_;
+    }
+
+    T * allocate( size_type n )
+    {
+        return n == 0 ? nullptr : alloc_traits::allocate( alloc_, n );
+    }
+
+    void deallocate( T * p, size_type n ) noexcept
+    {
+        if ( p != nullptr )
+        {
+            alloc_traits::deallocate( alloc_, p, n );
+        }
+    }
+
+    void reallocate( size_type n )
+    {
+        T * const fresh = allocate( n );
+
+#if !optional_CONFIG_NO_EXCEPTIONS
+        try
+#endif
+        {
+            transfer( fresh, trivially_relocatable() );
+        }
+#if !optional_CONFIG_NO_EXCEPTIONS
+        catch ( ... )
+        {
+            deallocate( fresh, n );
+            throw;
+        }
+#endif
+        deallocate( data_, capacity_ );
+
+        data_ = fresh;
+        capacity_ = n;
+    }
+
+    // the new element is constructed first, as args may refer into the old storage:
+
+    template< typename... Args >
+    void grow_and_emplace_back( Args&&... args )
+    {
+        size_type const n = next_capacity();
+        T * const fresh = allocate( n );
+
+#if !optional_CONFIG_NO_EXCEPTIONS
+        try
+#endif
+        {
+            alloc_traits::construct( alloc_, fresh + size_, std::forward<Args>( args )... );
+        }
+#if !optional_CONFIG_NO_EXCEPTIONS
+        catch ( ... )
+        {
+            deallocate( fresh, n );
+            throw;
+        }
+
+        try
+#endif
+        {
+            transfer( fresh, trivially_relocatable() );
+        }
+#if !optional_CONFIG_NO_EXCEPTIONS
+        catch ( ... )
+        {
+            alloc_traits::destroy( alloc_, fresh + size_ );
+            deallocate( fresh, n );
+            throw;
+        }
+#endif
+        deallocate( data_, capacity_ );
+
+        data_ = fresh;
+        capacity_ = n;
+        ++size_;
+    }
+
+    void transfer( T * fresh, std::true_type /*trivial*/ ) noexcept
+    {
+        detail::uninitialized_relocate( data_, data_ + size_, fresh, std::true_type() );
+    }
+
+    void transfer( T * fresh, std::false_type /*trivial*/ )
+    {
+        size_type i = 0;
+#if !optional_CONFIG_NO_EXCEPTIONS
+        try
+#endif
+        {
+            for ( ; i < size_; ++i )
+            {
+                alloc_traits::construct( alloc_, fresh + i, std::move_if_noexcept( data_[i] ) );
+            }
+        }
+#if !optional_CONFIG_NO_EXCEPTIONS
+        catch ( ... )
+        {
+            while ( i > 0 ) alloc_traits::destroy( alloc_, fresh + --i );
+            throw;
+        }
+#endif
+        for ( i = 0; i < size_; ++i )
+        {
+            alloc_traits::destroy( alloc_, data_ + i );
+        }
+    }
+
+private:
+    T * data_;
+    size_type size_;
+    size_type capacity_;
+    Allocator alloc_;
+};
+
+template< typename T, typename A >
+inline void swap( relocating_vector<T, A> & x, relocating_vector<T, A> & y ) noexcept
+{
+    x.swap( y );
+}
+
+} // namespace optional_lite
+
+using optional_lite::relocate_at;
+using optional_lite::uninitialized_relocate;
+using optional_lite::uninitialized_relocate_n;
+using optional_lite::relocating_vector;
+
+} // namespace nonstd
+
+#endif // optional_CPP11_OR_GREATER
+
+#endif // NONSTD_OPTIONAL_RELOCATE_LITE_HPP
@@ -0,0 +1,239 @@
+//
+// Copyright (c) 2026 Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#ifndef NONSTD_OPTIONAL_SHARED_LITE_HPP
+#define NONSTD_OPTIONAL_SHARED_LITE_HPP
+
+#include "nonstd/optional.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+//
+// Sequence lock:
+//
+// A writer makes the sequence number odd, writes the value and makes the
+// sequence number even again. A reader reads the sequence number, copies the
+// value and reads the sequence number again; if it was odd or has changed, a
+// write overlapped the copy and the reader retries. Readers do not write to
+// shared memory, so they do not contend with each other. The value is kept
+// in words that are read and written with relaxed atomic operations, so that
+// an overlapping copy is a retry rather than a data race.
+//
+
+namespace nonstd { namespace optional_lite {
+
+/// class shared_optional
+///
+/// An optional<T> for trivially copyable T that is written by one thread at a
+/// time and read by many without locking. Concurrent writers take turns.
+
+template< typename T >
+class shared_optional
+{
+    static_assert( std::is_trivially_copyable<T>::value, "shared_optional<T> requires trivially copyable T" );
+    static_assert( std::is_default_constructible<T>::value, "shared_optional<T> requires default constructible T" );
+
+    typedef std::uintptr_t word;
+    enum { words = ( sizeof( T ) + sizeof( word ) - 1 ) / sizeof( word ) };
+
+    // the value as words, copied from and to a T with std::memcpy:
+
+    typedef word buffer[ words ];
+
+public:
+    typedef T value_type;
+
+    shared_optional() noexcept
+    : seq_( 0 ), engaged_( false )
+    {
+        for ( auto & w : data_ )
+        {
+            w.store( 0, std::memory_order_relaxed );
+        }
+    }
+
+    shared_optional( nullopt_t ) noexcept
+    : shared_optional()
+    {}
+
+    explicit shared_optional( T const & value ) noexcept
+    : shared_optional()
+    {
+        store( value );
+    }
+
+    shared_optional( shared_optional const & ) = delete;
+    shared_optional & operator=( shared_optional const & ) = delete;
+
+    // readers:
+
+    optional<T> load() const noexcept
+    {
+        buffer copy = {};
+        bool engaged;
+
+        for ( ;; )
+        {
+            std::size_t const before = seq_.load( std::memory_order_acquire );
+
+            if ( before & 1 )
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            engaged = engaged_.load( std::memory_order_relaxed );
+
+            if ( engaged )
+            {
+                for ( std::size_t i = 0; i < words; ++i )
+                {
+                    copy[i] = data_[i].load( std::memory_order_relaxed );
+                }
+            }
+
+            std::atomic_thread_fence( std::memory_order_acquire );
+
+            if ( seq_.load( std::memory_order_relaxed ) == before )
+            {
+                break;
+            }
+        }
+
+        if ( !engaged )
+        {
+            return optional<T>();
+        }
+
+        T value;
+        std::memcpy( &value, copy, sizeof( T ) );
+        return optional<T>( value );
+    }
+
+    bool has_value() const noexcept
+    {
+        return load().has_value();
+    }
+
+    template< typename U >
+    T value_or( U && v ) const
+    {
+        return load().value_or( std::forward<U>( v ) );
+    }
+
+    // writers:
+
+    void store( T const & value ) noexcept
+    {
+        buffer copy = {};
+        std::memcpy( copy, &value, sizeof( T ) );
+
+        std::size_t const seq = lock();
+
+        engaged_.store( true, std::memory_order_relaxed );
+
+        for ( std::size_t i = 0; i < words; ++i )
+        {
+            data_[i].store( copy[i], std::memory_order_relaxed );
+        }
+
+        unlock( seq );
+    }
+
+    void store( optional<T> const & value ) noexcept
+    {
+        if ( value ) store( *value );
+        else         reset();
+    }
+
+    void reset() noexcept
+    {
+        std::size_t const seq = lock();
+
+        engaged_.store( false, std::memory_order_relaxed );
+
+        unlock( seq );
+    }
+
+    template< typename... Args >
+    void emplace( Args &&... args )
+    {
+        store( T( std::forward<Args>( args )... ) );
+    }
+
+    shared_optional & operator=( T const & value ) noexcept
+    {
+        store( value );
+        return *this;
+    }
+
+    shared_optional & operator=( nullopt_t ) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    // the number of completed writes:
+
+    std::size_t version() const noexcept
+    {
+        return seq_.load( std::memory_order_acquire ) / 2;
+    }
+
+private:
+    // make the sequence number odd, waiting for another writer to finish;
+    // a successful exchange acquires the previous writer's unlock():
+
+    std::size_t lock() noexcept
+    {
+        std::size_t seq = seq_.load( std::memory_order_relaxed );
+
+        while ( ( seq & 1 ) || !seq_.compare_exchange_weak( seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed ) )
+        {
+            if ( seq & 1 )
+            {
+                std::this_thread::yield();
+                seq = seq_.load( std::memory_order_relaxed );
+            }
+        }
+
+        std::atomic_thread_fence( std::memory_order_release );
+        return seq + 1;
+    }
+
+    void unlock( std::size_t seq ) noexcept
+    {
+        seq_.store( seq + 1, std::memory_order_release );
+    }
+
+    std::atomic<std::size_t> seq_;
+    std::atomic<bool> engaged_;
+    std::atomic<word> data_[ words ];
+};
+
+}} // namespace nonstd::optional_lite
+
+namespace nonstd {
+
+using optional_lite::shared_optional;
+
+} // namespace nonstd
+
+#endif // optional_CPP11_OR_GREATER
+
+#endif // NONSTD_OPTIONAL_SHARED_LITE_HPP
@@ -0,0 +1,300 @@
+//
+// Copyright (c) 2026 Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#ifndef NONSTD_OPTIONAL_SORT_LITE_HPP
+#define NONSTD_OPTIONAL_SORT_LITE_HPP
+
+#include "nonstd/optional_parallel.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+//
+// LSD radix sort of a random-access range of optional<T>, T integral, float or double:
+//
+// One pass collects the engaged values as unsigned keys that order as the values
+// do, one pass per significant key byte sorts the keys, and a last pass writes
+// the empty optionals first or last and the sorted values after or before them.
+// With empties_first, the result is ordered as by optional's operator<. Negative
+// and positive zero are equal to operator< and sort as -0.0 before +0.0; NaNs
+// sort before -inf or after +inf, depending on their sign bit.
+//
+// parallel::radix_sort() spreads each pass over threads, see optional_parallel.hpp.
+//
+
+namespace nonstd { namespace optional_lite {
+
+enum empty_order
+{
+    empties_first,
+    empties_last
+};
+
+namespace detail {
+
+template< std::size_t N > struct unsigned_of;
+template<> struct unsigned_of<1> { typedef std::uint8_t  type; };
+template<> struct unsigned_of<2> { typedef std::uint16_t type; };
+template<> struct unsigned_of<4> { typedef std::uint32_t type; };
+template<> struct unsigned_of<8> { typedef std::uint64_t type; };
+
+template< typename T >
+using radix_key_t = typename unsigned_of< sizeof( T ) >::type;
+
+template< typename K >
+constexpr K sign_bit()
+{
+    return K( K( 1 ) << ( 8 * sizeof( K ) - 1 ) );
+}
+
+// map a value to an unsigned key with the same order, and back:
+
+typedef std::integral_constant<int, 0> unsigned_kind;
+typedef std::integral_constant<int, 1> signed_kind;
+typedef std::integral_constant<int, 2> floating_kind;
+
+template< typename T >
+using radix_kind = std::integral_constant< int,
+    std::is_floating_point<T>::value ? 2 : std::is_signed<T>::value ? 1 : 0 >;
+
+template< typename T >
+radix_key_t<T> to_key( T value, unsigned_kind )
+{
+    return static_cast< radix_key_t<T> >( value );
+}
+
+template< typename T >
+T from_key( radix_key_t<T> key, unsigned_kind )
+{
+    return static_cast<T>( key );
+}
+
+template< typename T >
+radix_key_t<T> to_key( T value, signed_kind )
+{
+    return static_cast< radix_key_t<T> >( static_cast< radix_key_t<T> >( value ) ^ sign_bit< radix_key_t<T> >() );
+}
+
+template< typename T >
+T from_key( radix_key_t<T> key, signed_kind )
+{
+    return static_cast<T>( static_cast< radix_key_t<T> >( key ^ sign_bit< radix_key_t<T> >() ) );
+}
+
+template< typename T >
+radix_key_t<T> to_key( T value, floating_kind )
+{
+    typedef radix_key_t<T> K;
+
+    K bits;
+    std::memcpy( &bits, &value, sizeof( bits ) );
+
+    return ( bits & sign_bit<K>() ) ? K( ~bits ) : K( bits | sign_bit<K>() );
+}
+
+template< typename T >
+T from_key( radix_key_t<T> key, floating_kind )
+{
+    typedef radix_key_t<T> K;
+
+    K const bits = ( key & sign_bit<K>() ) ? K( key & ~sign_bit<K>() ) : K( ~key );
+
+    T value;
+    std::memcpy( &value, &bits, sizeof( value ) );
+    return value;
+}
+
+// one stable counting pass on byte shift / 8 of the keys, from src into dst;
+// blocks of [0, n) are counted and scattered on separate threads:
+
+template< typename K >
+bool radix_pass( std::vector<K> const & src, std::vector<K> & dst, unsigned shift, std::size_t block, unsigned threads )
+{
+    std::size_t const n = src.size();
+    std::size_t const blocks = ( n + block - 1 ) / block;
+    std::vector< std::array<std::size_t, 256> > offsets( blocks );
+
+    parallel::detail::for_each_chunk( n, block, threads, [&]( std::size_t b, std::size_t lo, std::size_t hi )
+    {
+        std::array<std::size_t, 256> & count = offsets[b];
+        count.fill( 0 );
+        for ( std::size_t i = lo; i < hi; ++i )
+        {
+            ++count[ ( src[i] >> shift ) & 0xff ];
+        }
+    } );
+
+    // a pass where all keys have the same byte leaves their order unchanged:
+
+    for ( std::size_t digit = 0; digit < 256; ++digit )
+    {
+        std::size_t total = 0;
+        for ( std::size_t b = 0; b < blocks; ++b )
+        {
+            total += offsets[b][digit];
+        }
+        if ( total == n )
+        {
+            return false;
+        }
+        if ( total != 0 )
+        {
+            break;
+        }
+    }
+
+    std::size_t start = 0;
+    for ( std::size_t digit = 0; digit < 256; ++digit )
+    {
+        for ( std::size_t b = 0; b < blocks; ++b )
+        {
+            std::size_t const count = offsets[b][digit];
+            offsets[b][digit] = start;
+            start += count;
+        }
+    }
+
+    parallel::detail::for_each_chunk( n, block, threads, [&]( std::size_t b, std::size_t lo, std::size_t hi )
+    {
+        std::array<std::size_t, 256> & next = offsets[b];
+        for ( std::size_t i = lo; i < hi; ++i )
+        {
+            dst[ next[ ( src[i] >> shift ) & 0xff ]++ ] = src[i];
+        }
+    } );
+
+    return true;
+}
+
+template< typename Iterator >
+void radix_sort( Iterator first, Iterator last, empty_order order, unsigned threads )
+{
+    typedef parallel::detail::value_t<Iterator> T;
+    typedef radix_key_t<T> K;
+    typedef radix_kind<T> kind;
+
+    static_assert( std::is_integral<T>::value || std::is_same<T, float>::value || std::is_same<T, double>::value,
+        "radix_sort() requires optional<T> with T integral, float or double" );
+
+    using parallel::detail::at;
+
+    std::size_t const n = static_cast<std::size_t>( last - first );
+    std::size_t const workers = parallel::detail::thread_count( threads );
+    std::size_t const block = (std::max)( std::size_t( 4096 ), ( n + workers - 1 ) / workers );
+    std::size_t const blocks = ( n + block - 1 ) / block;
+
+    // the engaged values as keys, in order:
+
+    std::vector<std::size_t> engaged( blocks + 1 );
+
+    parallel::detail::for_each_chunk( n, block, threads, [&]( std::size_t b, std::size_t lo, std::size_t hi )
+    {
+        std::size_t count = 0;
+        for ( std::size_t i = lo; i < hi; ++i )
+        {
+            count += at( first, i ).has_value();
+        }
+        engaged[ b + 1 ] = count;
+    } );
+
+    for ( std::size_t b = 0; b < blocks; ++b )
+    {
+        engaged[ b + 1 ] += engaged[b];
+    }
+
+    std::size_t const m = engaged[ blocks ];
+    std::vector<K> keys( m );
+    std::vector<K> buffer( m );
+
+    parallel::detail::for_each_chunk( n, block, threads, [&]( std::size_t b, std::size_t lo, std::size_t hi )
+    {
+        std::size_t out = engaged[b];
+        for ( std::size_t i = lo; i < hi; ++i )
+        {
+            if ( at( first, i ).has_value() )
+            {
+                keys[ out++ ] = to_key<T>( *at( first, i ), kind() );
+            }
+        }
+    } );
+
+    // sort the keys, byte by byte, least significant first:
+
+    std::size_t const key_block = (std::max)( std::size_t( 4096 ), ( m + workers - 1 ) / workers );
+
+    for ( unsigned shift = 0; shift < 8 * sizeof( K ); shift += 8 )
+    {
+        if ( radix_pass( keys, buffer, shift, key_block, threads ) )
+        {
+            keys.swap( buffer );
+        }
+    }
+
+    // write the empties and the sorted values back:
+
+    std::size_t const empties = n - m;
+    std::size_t const offset = order == empties_first ? empties : 0;
+
+    parallel::detail::for_each_chunk( n, block, threads, [&]( std::size_t, std::size_t lo, std::size_t hi )
+    {
+        for ( std::size_t i = lo; i < hi; ++i )
+        {
+            if ( i < offset || i >= offset + m )
+            {
+                at( first, i ) = nullopt;
+            }
+            else
+            {
+                at( first, i ) = from_key<T>( keys[ i - offset ], kind() );
+            }
+        }
+    } );
+}
+
+} // namespace detail
+
+/// sort the optional integral or floating-point values of [first, last),
+/// with the empty optionals first (as operator<) or last:
+
+template< typename Iterator >
+void radix_sort( Iterator first, Iterator last, empty_order order = empties_first )
+{
+    detail::radix_sort( first, last, order, 1 );
+}
+
+namespace parallel {
+
+/// radix_sort() on threads threads:
+
+template< typename Iterator >
+void radix_sort( Iterator first, Iterator last, empty_order order = empties_first, unsigned threads = 0 )
+{
+    optional_lite::detail::radix_sort( first, last, order, threads );
+}
+
+} // namespace parallel
+
+}} // namespace nonstd::optional_lite
+
+namespace nonstd {
+
+using optional_lite::empty_order;
+using optional_lite::empties_first;
+using optional_lite::empties_last;
+using optional_lite::radix_sort;
+
+} // namespace nonstd
+
+#endif // optional_CPP11_OR_GREATER
+
+#endif // NONSTD_OPTIONAL_SORT_LITE_HPP
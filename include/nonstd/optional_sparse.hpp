@@ -0,0 +1,393 @@
+//
+// Copyright (c) 2026 Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#ifndef NONSTD_OPTIONAL_SPARSE_LITE_HPP
+#define NONSTD_OPTIONAL_SPARSE_LITE_HPP
+
+#include "nonstd/optional.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace nonstd { namespace optional_lite {
+
+/// class sparse_optional_array
+///
+/// A sequence of optional<T> that stores the positions of the engaged elements
+/// in ascending order, and their values in a dense array in the same order.
+/// Memory is proportional to the number of engaged elements, not to size().
+/// Element access is a binary search over the positions; iteration visits the
+/// positions in order and costs O(1) per element. Setting an element inserts
+/// into or erases from the middle of the arrays, except at the end.
+
+template< typename T >
+class sparse_optional_array
+{
+public:
+    typedef optional<T>     value_type;
+    typedef std::size_t     size_type;
+    typedef std::ptrdiff_t  difference_type;
+
+    class const_iterator;
+
+    sparse_optional_array() noexcept
+    : size_( 0 )
+    {}
+
+    explicit sparse_optional_array( size_type n )
+    : size_( n )
+    {}
+
+    sparse_optional_array( std::initializer_list<value_type> il )
+    : size_( 0 )
+    {
+        assign( il.begin(), il.end() );
+    }
+
+    template< typename InputIt >
+    sparse_optional_array( InputIt first, InputIt last )
+    : size_( 0 )
+    {
+        assign( first, last );
+    }
+
+    template< typename InputIt >
+    void assign( InputIt first, InputIt last )
+    {
+        clear();
+        for ( ; first != last; ++first )
+        {
+            push_back( *first );
+        }
+    }
+
+    // capacity:
+
+    size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    size_type count_engaged() const noexcept
+    {
+        return values_.size();
+    }
+
+    size_type count_empty() const noexcept
+    {
+        return size_ - values_.size();
+    }
+
+    void reserve_engaged( size_type n )
+    {
+        positions_.reserve( n );
+        values_.reserve( n );
+    }
+
+    // Memory in use by the element storage, in bytes:
+
+    size_type memory_size() const noexcept
+    {
+        return positions_.capacity() * sizeof( size_type ) + values_.capacity() * sizeof( T );
+    }
+
+    // element access:
+
+    value_type operator[]( size_type pos ) const
+    {
+        return get( pos );
+    }
+
+    value_type get( size_type pos ) const
+    {
+        assert( pos < size_ );
+
+        size_type const k = rank( pos );
+
+        return k < positions_.size() && positions_[k] == pos ? value_type( values_[k] ) : value_type();
+    }
+
+    bool has_value( size_type pos ) const
+    {
+        assert( pos < size_ );
+
+        size_type const k = rank( pos );
+
+        return k < positions_.size() && positions_[k] == pos;
+    }
+
+    void set( size_type pos, value_type const & v )
+    {
+        assert( pos < size_ );
+
+        size_type const k = rank( pos );
+        bool const present = k < positions_.size() && positions_[k] == pos;
+
+        if ( v.has_value() )
+        {
+            if ( present )
+            {
+                values_[k] = *v;
+            }
+            else
+            {
+                insert_engaged( k, pos, *v );
+            }
+        }
+        else if ( present )
+        {
+            positions_.erase( positions_.begin() + static_cast<difference_type>( k ) );
+            values_.erase( values_.begin() + static_cast<difference_type>( k ) );
+        }
+    }
+
+    void reset( size_type pos )
+    {
+        set( pos, nullopt );
+    }
+
+    // The engaged elements: their positions in ascending order, and their values:
+
+    std::vector<size_type> const & positions() const noexcept
+    {
+        return positions_;
+    }
+
+    std::vector<T> const & values() const noexcept
+    {
+        return values_;
+    }
+
+    // iterators:
+
+    const_iterator begin()  const noexcept;
+    const_iterator end()    const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend()   const noexcept;
+
+    // modifiers:
+
+    void clear() noexcept
+    {
+        positions_.clear();
+        values_.clear();
+        size_ = 0;
+    }
+
+    void push_back( value_type const & v )
+    {
+        if ( v.has_value() )
+        {
+            insert_engaged( positions_.size(), size_, *v );
+        }
+        ++size_;
+    }
+
+    void pop_back()
+    {
+        assert( size_ > 0 );
+        resize( size_ - 1 );
+    }
+
+    // grows with empty elements:
+
+    void resize( size_type n )
+    {
+        size_type const k = rank( n );
+
+        positions_.erase( positions_.begin() + static_cast<difference_type>( k ), positions_.end() );
+        values_.erase( values_.begin() + static_cast<difference_type>( k ), values_.end() );
+        size_ = n;
+    }
+
+    void shrink_to_fit()
+    {
+        positions_.shrink_to_fit();
+        values_.shrink_to_fit();
+    }
+
+    void swap( sparse_optional_array & other ) noexcept
+    {
+        positions_.swap( other.positions_ );
+        values_.swap( other.values_ );
+        std::swap( size_, other.size_ );
+    }
+
+    // conversion to a dense container:
+
+    std::vector<value_type> to_vector() const
+    {
+        return std::vector<value_type>( begin(), end() );
+    }
+
+    friend bool operator==( sparse_optional_array const & x, sparse_optional_array const & y )
+    {
+        return x.size_ == y.size_ && x.positions_ == y.positions_ && x.values_ == y.values_;
+    }
+
+    friend bool operator!=( sparse_optional_array const & x, sparse_optional_array const & y )
+    {
+        return !( x == y );
+    }
+
+private:
+    // the number of engaged elements before pos:
+
+    size_type rank( size_type pos ) const
+    {
+        return static_cast<size_type>( std::lower_bound( positions_.begin(), positions_.end(), pos ) - positions_.begin() );
+    }
+
+    // insert pos and value as the k-th engaged element; if inserting the value
+    // throws, also remove pos so that positions and values stay in step:
+
+    void insert_engaged( size_type k, size_type pos, T const & value )
+    {
+        positions_.insert( positions_.begin() + static_cast<difference_type>( k ), pos );
+#if !optional_CONFIG_NO_EXCEPTIONS
+        try
+#endif
+        {
+            values_.insert( values_.begin() + static_cast<difference_type>( k ), value );
+        }
+#if !optional_CONFIG_NO_EXCEPTIONS
+        catch ( ... )
+        {
+            positions_.erase( positions_.begin() + static_cast<difference_type>( k ) );
+            throw;
+        }
+#endif
+    }
+
+private:
+    std::vector<size_type> positions_;
+    std::vector<T> values_;
+    size_type size_;
+};
+
+/// forward iterator yielding optional<T> by value
+
+template< typename T >
+class sparse_optional_array<T>::const_iterator
+{
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef optional<T>               value_type;
+    typedef std::ptrdiff_t            difference_type;
+    typedef void                      pointer;
+    typedef value_type                reference;
+
+    const_iterator() noexcept
+    : array_( nullptr ), pos_( 0 ), next_( 0 )
+    {}
+
+    value_type operator*() const
+    {
+        return next_ < array_->positions_.size() && array_->positions_[ next_ ] == pos_
+            ? value_type( array_->values_[ next_ ] ) : value_type();
+    }
+
+    const_iterator & operator++()
+    {
+        if ( next_ < array_->positions_.size() && array_->positions_[ next_ ] == pos_ )
+        {
+            ++next_;
+        }
+        ++pos_;
+        return *this;
+    }
+
+    const_iterator operator++( int )
+    {
+        const_iterator tmp( *this );
+        ++*this;
+        return tmp;
+    }
+
+    size_type position() const noexcept
+    {
+        return pos_;
+    }
+
+    friend bool operator==( const_iterator const & a, const_iterator const & b ) noexcept
+    {
+        return a.pos_ == b.pos_;
+    }
+
+    friend bool operator!=( const_iterator const & a, const_iterator const & b ) noexcept
+    {
+        return !( a == b );
+    }
+
+private:
+    friend class sparse_optional_array;
+
+    const_iterator( sparse_optional_array const * array, size_type pos, size_type next ) noexcept
+    : array_( array ), pos_( pos ), next_( next )
+    {}
+
+    sparse_optional_array const * array_;
+    size_type pos_;     // element position
+    size_type next_;    // index of the first engaged element at or after pos_
+};
+
+template< typename T >
+inline typename sparse_optional_array<T>::const_iterator sparse_optional_array<T>::begin() const noexcept
+{
+    return const_iterator( this, 0, 0 );
+}
+
+template< typename T >
+inline typename sparse_optional_array<T>::const_iterator sparse_optional_array<T>::end() const noexcept
+{
+    return const_iterator( this, size_, positions_.size() );
+}
+
+template< typename T >
+inline typename sparse_optional_array<T>::const_iterator sparse_optional_array<T>::cbegin() const noexcept
+{
+    return begin();
+}
+
+template< typename T >
+inline typename sparse_optional_array<T>::const_iterator sparse_optional_array<T>::cend() const noexcept
+{
+    return end();
+}
+
+template< typename T >
+inline void swap( sparse_optional_array<T> & x, sparse_optional_array<T> & y ) noexcept
+{
+    x.swap( y );
+}
+
+}} // namespace nonstd::optional_lite
+
+namespace nonstd {
+
+using optional_lite::sparse_optional_array;
+
+} // namespace nonstd
+
+#endif // optional_CPP11_OR_GREATER
+
+#endif // NONSTD_OPTIONAL_SPARSE_LITE_HPP
@@ -0,0 +1,110 @@
+//
+// Copyright (c) 2026 Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// C++20 module interface unit nonstd.optional:
+//
+// The module is built from nonstd/optional.hpp, with the configuration macros
+// optional_CONFIG_* given on the command line of the module build; macros do
+// not pass an import. The module always provides nonstd::optional, never an
+// alias of std::optional. The configuration that it was built with is
+// available to importers as constants in nonstd::optional_config.
+//
+// Instrumentation and layout audit (optional_CONFIG_INSTRUMENT and
+// optional_CONFIG_LAYOUT_AUDIT) are available via the header only.
+//
+
+module;
+
+#if !defined( optional_CONFIG_SELECT_OPTIONAL )
+# define optional_CONFIG_SELECT_OPTIONAL  optional_OPTIONAL_NONSTD
+#endif
+
+#include "nonstd/optional.hpp"
+
+#if optional_USES_STD_OPTIONAL
+# error optional-lite: module nonstd.optional requires optional_CONFIG_SELECT_OPTIONAL=optional_OPTIONAL_NONSTD; for std::optional, import std.
+#endif
+
+#if optional_CONFIG_INSTRUMENT || optional_CONFIG_LAYOUT_AUDIT
+# error optional-lite: module nonstd.optional does not support optional_CONFIG_INSTRUMENT or optional_CONFIG_LAYOUT_AUDIT; use the header.
+#endif
+
+export module nonstd.optional;
+
+export namespace nonstd {
+
+using optional_lite::optional;
+using optional_lite::nullopt_t;
+using optional_lite::nullopt;
+using optional_lite::make_optional;
+
+#if !optional_CONFIG_NO_EXCEPTIONS
+using optional_lite::bad_optional_access;
+#endif
+
+using nonstd::in_place;
+using nonstd::in_place_t;
+using nonstd::in_place_type;
+using nonstd::in_place_type_t;
+using nonstd::in_place_index;
+using nonstd::in_place_index_t;
+
+#if !optional_CONFIG_NO_EXTENSIONS
+using optional_lite::in_place_invoke_t;
+using optional_lite::in_place_invoke;
+#endif
+
+// the configuration of this build of the module:
+
+namespace optional_config {
+
+inline constexpr bool extensions             = !optional_CONFIG_NO_EXTENSIONS;
+inline constexpr bool exceptions             = !optional_CONFIG_NO_EXCEPTIONS;
+inline constexpr bool bad_access_logic_error = optional_CONFIG_BAD_ACCESS_LOGIC_ERROR;
+
+enum class bad_access_response
+{
+    assert_ = optional_ON_BAD_ACCESS_ASSERT,
+    throw_  = optional_ON_BAD_ACCESS_THROW,
+    trap    = optional_ON_BAD_ACCESS_TRAP,
+    hook    = optional_ON_BAD_ACCESS_HOOK,
+};
+
+inline constexpr bad_access_response on_bad_access = bad_access_response( optional_CONFIG_ON_BAD_ACCESS );
+
+} // namespace optional_config
+
+} // namespace nonstd
+
+// the non-member functions, for argument-dependent lookup from importers:
+
+export namespace nonstd::optional_lite {
+
+using optional_lite::operator==;
+
+#if optional_HAVE( THREE_WAY_COMPARISON )
+using optional_lite::operator<=>;
+#else
+using optional_lite::operator!=;
+using optional_lite::operator<;
+using optional_lite::operator<=;
+using optional_lite::operator>;
+using optional_lite::operator>=;
+#endif
+
+using optional_lite::swap;
+using optional_lite::make_optional;
+
+#if optional_CONFIG_ON_BAD_ACCESS == optional_ON_BAD_ACCESS_HOOK
+using optional_lite::on_bad_access;
+#endif
+
+} // namespace nonstd::optional_lite
+
+// end of file
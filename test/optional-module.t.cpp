@@ -0,0 +1,73 @@
+// Copyright 2026 by Martin Moene
+//
+// https://github.com/martinmoene/optional-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Uses optional lite via the C++20 module nonstd.optional, without including
+// nonstd/optional.hpp. Built with OPTIONAL_LITE_OPT_BUILD_MODULE=ON only.
+
+#include "lest_cpp03.hpp"
+
+#include <string>
+#include <utility>
+
+import nonstd.optional;
+
+#define CASE( name ) lest_CASE( specification(), name )
+
+static lest::tests & specification()
+{
+    static lest::tests tests;
+    return tests;
+}
+
+CASE( "module: Allows to construct, observe and reset an optional" )
+{
+    nonstd::optional<int> e( 7 );
+    nonstd::optional<int> d;
+    nonstd::optional<std::string> s( nonstd::in_place, std::size_t( 3 ), 'x' );
+
+    EXPECT( e.has_value() );
+    EXPECT( *e == 7 );
+    EXPECT( d.value_or( 42 ) == 42 );
+    EXPECT( s.value() == "xxx" );
+    EXPECT( nonstd::make_optional( 5 ).value() == 5 );
+
+    e.reset();
+
+    EXPECT_NOT( e.has_value() );
+}
+
+CASE( "module: Provides the non-member operators via argument-dependent lookup" )
+{
+    nonstd::optional<int> e1( 6 );
+    nonstd::optional<int> e2( 7 );
+    nonstd::optional<int> d;
+
+    EXPECT(( e1 == 6 && 6 == e1 ));
+    EXPECT(( e1 != e2 && e1 < e2 && e2 >= e1 ));
+    EXPECT(( d == nonstd::nullopt && d < e1 ));
+
+    swap( d, e1 );
+
+    EXPECT(( d == 6 && e1 == nonstd::nullopt ));
+}
+
+CASE( "module: Throws bad_optional_access at disengaged access" )
+{
+    if ( nonstd::optional_config::exceptions && nonstd::optional_config::on_bad_access == nonstd::optional_config::bad_access_response::throw_ )
+    {
+        nonstd::optional<int> d;
+
+        EXPECT_THROWS_AS( d.value(), nonstd::bad_optional_access );
+    }
+}
+
+int main( int argc, char * argv[] )
+{
+    return lest::run( specification(), argc, argv );
+}
+
+// end of file
@@ -0,0 +1,125 @@
+//
+// Copyright 2026 by Martin Moene
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "optional-main.t.hpp"
+#include "nonstd/optional_arrow.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace nonstd;
+
+// the C consumer and producer, see optional_arrow_consumer.c:
+
+extern "C" {
+
+int64_t arrow_consumer_sum( struct ArrowArray * array, struct ArrowSchema * schema, int64_t * nulls, int * nullable );
+void arrow_producer_make( struct ArrowArray * array, struct ArrowSchema * schema, int64_t length );
+
+}
+
+#endif
+
+CASE( "arrow: Allows to export columns to a C consumer without copying (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    std::vector< optional<std::int64_t> > rows( 100 );
+
+    for ( std::size_t i = 0; i < rows.size(); ++i )
+    {
+        if ( i % 4 ) rows[i] = std::int64_t( i );
+    }
+
+    optional_columns<std::int64_t> columns = to_columns( rows );
+    std::int64_t const * values = columns.values.data();
+
+    ArrowArray array;
+    ArrowSchema schema;
+
+    export_arrow( std::move( columns ), &array, &schema, "x" );
+
+    EXPECT( std::strcmp( schema.format, "l" ) == 0 );
+    EXPECT( std::strcmp( schema.name, "x" ) == 0 );
+    EXPECT( array.length == 100 );
+    EXPECT( array.null_count == 25 );
+    EXPECT( array.buffers[1] == values );
+
+    int64_t nulls = 0;
+    int nullable = 0;
+
+    EXPECT( arrow_consumer_sum( &array, &schema, &nulls, &nullable ) == 4950 - ( 0 + 96 ) * 25 / 2 );
+    EXPECT( nulls == 25 );
+    EXPECT( nullable == 1 );
+    EXPECT( ( array.release == nullptr ) );
+    EXPECT( ( schema.release == nullptr ) );
+#else
+    EXPECT( !!"arrow: not available (no C++11)" );
+#endif
+}
+
+CASE( "arrow: Allows to view an array of a C producer as optionals (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    ArrowArray array;
+    ArrowSchema schema;
+
+    arrow_producer_make( &array, &schema, 10 );
+
+    optional< arrow_optional_view<double> > const view = import_arrow<double>( array, schema );
+
+    EXPECT( !!view );
+    EXPECT( view->size() == 10u );
+    EXPECT( ( *view )[0].value() == 0.5 );
+    EXPECT( !( *view )[2] );
+    EXPECT( ( *view )[9].value() == 9.5 );
+
+    std::size_t engaged = 0;
+    for ( optional<double> x : *view )
+    {
+        engaged += x.has_value();
+    }
+    EXPECT( engaged == 7u );
+
+    EXPECT( !import_arrow<float>( array, schema ) );
+    EXPECT( !import_arrow<std::int64_t>( array, schema ) );
+
+    array.release( &array );
+    schema.release( &schema );
+
+    EXPECT( !import_arrow<double>( array, schema ) );
+#else
+    EXPECT( !!"arrow: not available (no C++11)" );
+#endif
+}
+
+CASE( "arrow: Allows to round-trip columns through the C data interface (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    std::vector< optional<std::int32_t> > const rows = { 1, nullopt, 3, nullopt, 5 };
+
+    ArrowArray array;
+    ArrowSchema schema;
+
+    export_arrow( to_columns( rows ), &array, &schema );
+
+    optional< arrow_optional_view<std::int32_t> > const view = import_arrow<std::int32_t>( array, schema );
+
+    EXPECT( ( std::vector< optional<std::int32_t> >( view->begin(), view->end() ) == rows ) );
+
+    int64_t nulls = 0;
+    int nullable = 0;
+
+    EXPECT( arrow_consumer_sum( &array, &schema, &nulls, &nullable ) == 9 );
+    EXPECT( nulls == 2 );
+#else
+    EXPECT( !!"arrow: not available (no C++11)" );
+#endif
+}
+
+// end of file
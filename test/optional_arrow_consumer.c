@@ -0,0 +1,180 @@
+/*
+ * Copyright 2026 by Martin Moene
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+/*
+ * A C consumer and producer of Arrow arrays for the tests of
+ * nonstd/optional_arrow.hpp, using the C data interface structs only.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema
+{
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+    void (*release)(struct ArrowSchema*);
+    void* private_data;
+};
+
+struct ArrowArray
+{
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+    void (*release)(struct ArrowArray*);
+    void* private_data;
+};
+
+#endif /* ARROW_C_DATA_INTERFACE */
+
+static int is_valid( struct ArrowArray const * array, int64_t i )
+{
+    unsigned char const * validity = (unsigned char const *) array->buffers[0];
+    int64_t const bit = array->offset + i;
+
+    return validity == NULL || ( ( validity[ bit / 8 ] >> ( bit % 8 ) ) & 1 );
+}
+
+/*
+ * Consume a nullable int32 ("i") or int64 ("l") array: return the sum of its
+ * valid values, store the number of nulls counted, and release both structs.
+ * Return -1 for another format.
+ */
+
+int64_t arrow_consumer_sum( struct ArrowArray * array, struct ArrowSchema * schema, int64_t * nulls, int * nullable )
+{
+    int64_t sum = 0;
+    int64_t i;
+
+    *nulls = 0;
+    *nullable = ( schema->flags & ARROW_FLAG_NULLABLE ) != 0;
+
+    if ( strcmp( schema->format, "i" ) != 0 && strcmp( schema->format, "l" ) != 0 )
+    {
+        sum = -1;
+    }
+    else
+    {
+        for ( i = 0; i < array->length; ++i )
+        {
+            if ( !is_valid( array, i ) )
+            {
+                ++*nulls;
+            }
+            else if ( schema->format[0] == 'i' )
+            {
+                sum += ( (int32_t const *) array->buffers[1] )[ array->offset + i ];
+            }
+            else
+            {
+                sum += ( (int64_t const *) array->buffers[1] )[ array->offset + i ];
+            }
+        }
+    }
+
+    array->release( array );
+    schema->release( schema );
+
+    return sum;
+}
+
+/*
+ * Produce a nullable double ("g") array of the values 0.5, 1.5, ... of which
+ * every third is null, starting at offset 3 in its buffers.
+ */
+
+struct producer_data
+{
+    const void * buffers[2];
+    unsigned char * validity;
+    double * values;
+};
+
+static void release_array( struct ArrowArray * array )
+{
+    struct producer_data * data = (struct producer_data *) array->private_data;
+
+    free( data->validity );
+    free( data->values );
+    free( data );
+    array->release = NULL;
+}
+
+static void release_schema( struct ArrowSchema * schema )
+{
+    schema->release = NULL;
+}
+
+void arrow_producer_make( struct ArrowArray * array, struct ArrowSchema * schema, int64_t length )
+{
+    int64_t const offset = 3;
+    int64_t const total = offset + length;
+    struct producer_data * data = (struct producer_data *) malloc( sizeof( *data ) );
+    int64_t i;
+
+    data->validity = (unsigned char *) calloc( (size_t)( total + 7 ) / 8, 1 );
+    data->values = (double *) malloc( (size_t) total * sizeof( double ) );
+    data->buffers[0] = data->validity;
+    data->buffers[1] = data->values;
+
+    array->null_count = 0;
+
+    for ( i = 0; i < length; ++i )
+    {
+        data->values[ offset + i ] = (double) i + 0.5;
+
+        if ( i % 3 == 2 )
+        {
+            ++array->null_count;
+        }
+        else
+        {
+            data->validity[ ( offset + i ) / 8 ] |= (unsigned char)( 1u << ( ( offset + i ) % 8 ) );
+        }
+    }
+
+    array->length       = length;
+    array->offset       = offset;
+    array->n_buffers    = 2;
+    array->n_children   = 0;
+    array->buffers      = data->buffers;
+    array->children     = NULL;
+    array->dictionary   = NULL;
+    array->release      = release_array;
+    array->private_data = data;
+
+    schema->format       = "g";
+    schema->name         = "produced";
+    schema->metadata     = NULL;
+    schema->flags        = ARROW_FLAG_NULLABLE;
+    schema->n_children   = 0;
+    schema->children     = NULL;
+    schema->dictionary   = NULL;
+    schema->release      = release_schema;
+    schema->private_data = NULL;
+}
+
+/* end of file */
@@ -0,0 +1,114 @@
+//
+// Copyright 2026 by Martin Moene
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "optional-main.t.hpp"
+#include "nonstd/optional_bool_vector.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+using namespace nonstd;
+
+namespace {
+
+const optional<bool> T_( true  );
+const optional<bool> F_( false );
+const optional<bool> E_;
+
+} // anonymous namespace
+
+#endif
+
+CASE( "optional_bool_vector: Allows to construct, set and get elements (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    optional_bool_vector v( 3 );
+
+    EXPECT( v.size() == 3u );
+    EXPECT( !v.get( 0 ) );
+
+    v[0] = T_;
+    v.set( 1, F_ );
+
+    EXPECT( v.get( 0 ) == T_ );
+    EXPECT( v.get( 1 ) == F_ );
+    EXPECT( v.get( 2 ) == E_ );
+
+    v.reset( 0 );
+
+    EXPECT( !v.get( 0 ) );
+#else
+    EXPECT( !!"optional_bool_vector: not available (no C++11)" );
+#endif
+}
+
+CASE( "optional_bool_vector: Allows to construct from initializer-list and iterate (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    optional_bool_vector v = { T_, E_, F_ };
+    std::vector< optional<bool> > w( v.begin(), v.end() );
+
+    EXPECT( w.size() == 3u );
+    EXPECT( w[0] == T_ );
+    EXPECT( w[1] == E_ );
+    EXPECT( w[2] == F_ );
+#else
+    EXPECT( !!"optional_bool_vector: not available (no C++11)" );
+#endif
+}
+
+CASE( "optional_bool_vector: Allows to count true, false and empty elements (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    optional_bool_vector v;
+
+    for ( int i = 0; i < 300; ++i )
+    {
+        v.push_back( i % 3 == 0 ? T_ : i % 3 == 1 ? F_ : E_ );
+    }
+
+    EXPECT( v.count_true()    == 100u );
+    EXPECT( v.count_false()   == 100u );
+    EXPECT( v.count_empty()   == 100u );
+    EXPECT( v.count_engaged() == 200u );
+
+    v.resize( 130 );
+
+    EXPECT( v.count_true()  == 44u );
+    EXPECT( v.count_false() == 43u );
+    EXPECT( v.count_empty() == 43u );
+#else
+    EXPECT( !!"optional_bool_vector: not available (no C++11)" );
+#endif
+}
+
+CASE( "optional_bool_vector: Provides three-valued logical and, or and not (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    //                      T   T   T   F   F   F   E   E   E
+    optional_bool_vector a{ T_, T_, T_, F_, F_, F_, E_, E_, E_ };
+    optional_bool_vector b{ T_, F_, E_, T_, F_, E_, T_, F_, E_ };
+
+    EXPECT(( ( a & b ) == optional_bool_vector({ T_, F_, E_, F_, F_, F_, E_, F_, E_ }) ));
+    EXPECT(( ( a | b ) == optional_bool_vector({ T_, T_, T_, T_, F_, E_, T_, E_, E_ }) ));
+    EXPECT((   ~a      == optional_bool_vector({ F_, F_, F_, T_, T_, T_, E_, E_, E_ }) ));
+#else
+    EXPECT( !!"optional_bool_vector: not available (no C++11)" );
+#endif
+}
+
+CASE( "optional_bool_vector: Uses two bits per element (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    optional_bool_vector v( 64 * 1000, T_ );
+
+    EXPECT( v.memory_size() == 64 * 1000 / 4 );
+    EXPECT( v.count_true()  == 64 * 1000u );
+#else
+    EXPECT( !!"optional_bool_vector: not available (no C++11)" );
+#endif
+}
+
+// end of file
@@ -0,0 +1,210 @@
+//
+// Copyright 2026 by Martin Moene
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "optional-main.t.hpp"
+#include "nonstd/optional_boxed.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+using namespace nonstd;
+
+namespace boxed {
+
+struct Large
+{
+    int id;
+    char payload[ 500 ];
+
+    explicit Large( int id_ = 0 ) : id( id_ ), payload() {}
+};
+
+inline bool operator==( Large const & a, Large const & b ) { return a.id == b.id; }
+inline bool operator< ( Large const & a, Large const & b ) { return a.id <  b.id; }
+
+} // namespace boxed
+
+#endif
+
+CASE( "boxed_optional: Is the size of a pointer (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    EXPECT( sizeof( boxed_optional<boxed::Large> ) == sizeof( void * ) );
+    EXPECT( sizeof( optional<boxed::Large> ) > sizeof( boxed::Large ) );
+#else
+    EXPECT( !!"boxed_optional: not available (no C++11)" );
+#endif
+}
+
+CASE( "boxed_optional: Allows to construct, assign and reset as optional (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    boxed_optional<std::string> d;
+    boxed_optional<std::string> n( nullopt );
+    boxed_optional<std::string> v( "hello" );
+    boxed_optional<std::string> i( in_place, 3, 'x' );
+
+    EXPECT( !d );
+    EXPECT( !n.has_value() );
+    EXPECT( *v == "hello" );
+    EXPECT( v->size() == 5u );
+    EXPECT( i.value() == "xxx" );
+
+    d = "world";
+    EXPECT( *d == "world" );
+
+    d = nullopt;
+    EXPECT( !d );
+
+    d.emplace( 2, 'y' );
+    EXPECT( *d == "yy" );
+
+    d.reset();
+    EXPECT( !d );
+    EXPECT( d.value_or( "none" ) == "none" );
+    EXPECT( v.value_or( "none" ) == "hello" );
+#else
+    EXPECT( !!"boxed_optional: not available (no C++11)" );
+#endif
+}
+
+CASE( "boxed_optional: Allows to copy, move and swap (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    boxed_optional<std::string> a( "a" );
+    boxed_optional<std::string> b( a );
+
+    EXPECT( *b == "a" );
+    EXPECT( &*a != &*b );
+
+    std::string const * p = &*a;
+    boxed_optional<std::string> c( std::move( a ) );
+
+    EXPECT( !a );
+    EXPECT( &*c == p );
+
+    boxed_optional<std::string> e;
+    swap( c, e );
+
+    EXPECT( !c );
+    EXPECT( &*e == p );
+
+    c = e;
+    EXPECT( *c == "a" );
+
+    b = boxed_optional<std::string>();
+    EXPECT( !b );
+#else
+    EXPECT( !!"boxed_optional: not available (no C++11)" );
+#endif
+}
+
+CASE( "boxed_optional: Throws bad_optional_access at access of an empty boxed_optional (C++11)" )
+{
+#if optional_CPP11_OR_GREATER && !optional_CONFIG_NO_EXCEPTIONS
+    boxed_optional<int> e;
+
+    EXPECT_THROWS_AS( e.value(), bad_optional_access );
+#else
+    EXPECT( !!"boxed_optional: not available (no C++11, or no exceptions)" );
+#endif
+}
+
+CASE( "boxed_optional: Compares as optional (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    boxed_optional<int> const e;
+    boxed_optional<int> const one( 1 );
+    boxed_optional<int> const two( 2 );
+
+    EXPECT( ( e == e ) );
+    EXPECT( ( e <  one ) );
+    EXPECT( ( one <  two ) );
+    EXPECT( ( two >  one ) );
+    EXPECT( ( one <= one ) );
+    EXPECT( ( one != two ) );
+
+    EXPECT( ( e == nullopt ) );
+    EXPECT( ( nullopt <  one ) );
+    EXPECT( ( one >  nullopt ) );
+    EXPECT( ( nullopt <= e ) );
+
+    EXPECT( ( one == 1 ) );
+    EXPECT( ( 2 == two ) );
+    EXPECT( ( e <  0 ) );
+    EXPECT( ( e != 0 ) );
+    EXPECT( ( one <  2 ) );
+    EXPECT( ( 2 >= two ) );
+#else
+    EXPECT( ( !!"boxed_optional: not available (no C++11)" ) );
+#endif
+}
+
+CASE( "boxed_optional: Is explicitly constructible from a value that does not convert to T (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    EXPECT(     ( std::is_convertible  < char const *, boxed_optional<std::string> >::value ) );
+    EXPECT(     ( std::is_constructible< boxed_optional<boxed::Large>, int >::value ) );
+    EXPECT_NOT( ( std::is_convertible  < int, boxed_optional<boxed::Large> >::value ) );
+
+    boxed_optional<boxed::Large> const b( 7 );
+
+    EXPECT( b->id == 7 );
+#else
+    EXPECT( !!"boxed_optional: not available (no C++11)" );
+#endif
+}
+
+CASE( "boxed_optional: Allows to convert from and to optional (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    optional<boxed::Large> const o( boxed::Large( 7 ) );
+    boxed_optional<boxed::Large> const b( o );
+
+    EXPECT( b->id == 7 );
+    EXPECT( b.to_optional()->id == 7 );
+    EXPECT( !boxed_optional<boxed::Large>( optional<boxed::Large>() ) );
+    EXPECT( !boxed_optional<boxed::Large>().to_optional() );
+#else
+    EXPECT( !!"boxed_optional: not available (no C++11)" );
+#endif
+}
+
+CASE( "boxed_optional: Reuses pool slots of released values (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    boxed_optional<boxed::Large> a( in_place, 1 );
+    boxed::Large const * p = &*a;
+
+    a.reset();
+    a.emplace( 2 );
+
+    EXPECT( &*a == p );
+    EXPECT( pool_allocator<boxed::Large>::pool_reserved() > 0u );
+#else
+    EXPECT( !!"boxed_optional: not available (no C++11)" );
+#endif
+}
+
+CASE( "boxed_optional: Allows to use another allocator (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    boxed_optional<boxed::Large, std::allocator<boxed::Large> > a( in_place, 3 );
+    boxed_optional<boxed::Large, std::allocator<boxed::Large> > b( a );
+
+    EXPECT( b->id == 3 );
+    EXPECT( ( a == b ) );
+    EXPECT( sizeof( a ) == sizeof( void * ) );
+#else
+    EXPECT( !!"boxed_optional: not available (no C++11)" );
+#endif
+}
+
+// end of file
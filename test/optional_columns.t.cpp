@@ -0,0 +1,106 @@
+//
+// Copyright 2026 by Martin Moene
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "optional-main.t.hpp"
+#include "nonstd/optional_columns.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace nonstd;
+
+namespace columns {
+
+// n rows with a full block of 64 engaged rows, an empty block, and a mix:
+
+std::vector< optional<int> > sample( int n )
+{
+    std::vector< optional<int> > v( static_cast<std::size_t>( n ) );
+
+    for ( int i = 0; i < n; ++i )
+    {
+        if ( i < 64 || ( i >= 128 && i % 5 == 0 ) ) v[ static_cast<std::size_t>( i ) ] = i;
+    }
+    return v;
+}
+
+} // namespace columns
+
+#endif
+
+CASE( "optional_columns: Allows to convert rows to values and a validity bitmap (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    std::vector< optional<int> > const rows = columns::sample( 200 );
+    optional_columns<int> const c = to_columns( rows );
+
+    EXPECT( c.size() == 200u );
+    EXPECT( c.validity.size() == 4u );
+    EXPECT( c.validity[0] == ~std::uint64_t( 0 ) );
+    EXPECT( c.validity[1] == 0u );
+    EXPECT( c.values[63] == 63 );
+    EXPECT( c.values[64] == 0 );
+    EXPECT( c.values[195] == 195 );
+    EXPECT( c.has_value( 130 ) );
+    EXPECT( !c.has_value( 131 ) );
+    EXPECT( c[130].value() == 130 );
+    EXPECT( !c[131] );
+    EXPECT( c.count_engaged() == 64u + 14u );
+
+    optional_columns<int> const part = to_columns( rows.begin() + 128, rows.begin() + 136 );
+
+    EXPECT( part.size() == 8u );
+    EXPECT( part.validity[0] == 0x84u );
+#else
+    EXPECT( !!"optional_columns: not available (no C++11)" );
+#endif
+}
+
+CASE( "optional_columns: Allows to convert values and a validity bitmap to rows (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    std::vector< optional<int> > const rows = columns::sample( 200 );
+
+    EXPECT( ( to_rows( to_columns( rows ) ) == rows ) );
+    EXPECT( to_rows( optional_columns<int>() ).empty() );
+
+    optional_columns<int> const c = to_columns( rows );
+
+    EXPECT( ( to_rows( c ) == rows ) );
+#else
+    EXPECT( !!"optional_columns: not available (no C++11)" );
+#endif
+}
+
+CASE( "optional_columns: Moves non-trivial values from an rvalue (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    std::vector< optional< std::unique_ptr<int> > > rows( 3 );
+    rows[0] = std::unique_ptr<int>( new int( 1 ) );
+    rows[2] = std::unique_ptr<int>( new int( 3 ) );
+
+    int const * p = rows[2]->get();
+
+    optional_columns< std::unique_ptr<int> > c = to_columns( std::move( rows ) );
+
+    EXPECT( c.values[2].get() == p );
+    EXPECT( !c.values[1] );
+
+    std::vector< optional< std::unique_ptr<int> > > const back = to_rows( std::move( c ) );
+
+    EXPECT( back[2]->get() == p );
+    EXPECT( **back[0] == 1 );
+    EXPECT( !back[1] );
+#else
+    EXPECT( !!"optional_columns: not available (no C++11)" );
+#endif
+}
+
+// end of file
@@ -0,0 +1,147 @@
+//
+// Copyright 2026 by Martin Moene
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "optional-main.t.hpp"
+#include "nonstd/optional_coroutine.hpp"
+
+#if optional_USES_COROUTINE
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace nonstd;
+
+namespace coro {
+
+optional<int> digit( char c )
+{
+    if ( c < '0' || c > '9' )
+        return nullopt;
+    return c - '0';
+}
+
+optional<int> number( std::string const & s )
+{
+    int result = 0;
+
+    for ( char c : s )
+    {
+        result = 10 * result + co_await digit( c );
+    }
+    co_return result;
+}
+
+optional<int> sum( optional<int> const & a, optional<int> const & b )
+{
+    co_return co_await a + co_await b;
+}
+
+// counts live instances to observe destruction of the coroutine's locals:
+
+struct Live
+{
+    static int & count() { static int n = 0; return n; }
+
+    Live()  { ++count(); }
+    Live( Live const & ) { ++count(); }
+    ~Live() { --count(); }
+};
+
+optional<int> guarded( optional<int> a )
+{
+    Live live;
+    co_return co_await a;
+}
+
+optional< std::unique_ptr<int> > boxed( optional< std::unique_ptr<int> > p )
+{
+    std::unique_ptr<int> q = co_await std::move( p );
+    *q += 1;
+    co_return std::move( q );
+}
+
+optional<int> empty()
+{
+    co_return nullopt;
+}
+
+// the parameter copy lives in the coroutine frame, so Live::count() also
+// observes the destruction of the frame:
+
+optional<int> throwing( Live, optional<int> a )
+{
+    Live live;
+    int const value = co_await a;
+    if ( value < 0 )
+        throw std::range_error( "negative" );
+    co_return value;
+}
+
+} // namespace coro
+
+#endif
+
+CASE( "coroutine: Allows to co_await an optional and co_return a value (C++20)" )
+{
+#if optional_USES_COROUTINE
+    EXPECT( coro::number( "1234" ).value() == 1234 );
+    EXPECT( coro::sum( 3, 4 ).value() == 7 );
+#else
+    EXPECT( !!"coroutine: not available (no C++20 coroutines, or std::optional)" );
+#endif
+}
+
+CASE( "coroutine: Returns nullopt on co_await of an empty optional (C++20)" )
+{
+#if optional_USES_COROUTINE
+    EXPECT( !coro::number( "12x4" ) );
+    EXPECT( !coro::sum( 3, nullopt ) );
+    EXPECT( !coro::sum( nullopt, 4 ) );
+    EXPECT( !coro::empty() );
+#else
+    EXPECT( !!"coroutine: not available (no C++20 coroutines, or std::optional)" );
+#endif
+}
+
+CASE( "coroutine: Destroys the locals of a coroutine that returns nullopt (C++20)" )
+{
+#if optional_USES_COROUTINE
+    EXPECT( !coro::guarded( nullopt ) );
+    EXPECT( coro::Live::count() == 0 );
+    EXPECT( coro::guarded( 5 ).value() == 5 );
+    EXPECT( coro::Live::count() == 0 );
+#else
+    EXPECT( !!"coroutine: not available (no C++20 coroutines, or std::optional)" );
+#endif
+}
+
+CASE( "coroutine: Propagates an exception and destroys the coroutine frame (C++20)" )
+{
+#if optional_USES_COROUTINE
+    EXPECT_THROWS_AS( coro::throwing( coro::Live(), -1 ), std::range_error );
+    EXPECT( coro::Live::count() == 0 );
+    EXPECT( coro::throwing( coro::Live(), 3 ).value() == 3 );
+    EXPECT( coro::Live::count() == 0 );
+#else
+    EXPECT( !!"coroutine: not available (no C++20 coroutines, or std::optional)" );
+#endif
+}
+
+CASE( "coroutine: Allows to co_await an rvalue optional of a move-only type (C++20)" )
+{
+#if optional_USES_COROUTINE
+    optional< std::unique_ptr<int> > r = coro::boxed( std::unique_ptr<int>( new int( 41 ) ) );
+
+    EXPECT( r.has_value() );
+    EXPECT( **r == 42 );
+    EXPECT( !coro::boxed( nullopt ) );
+#else
+    EXPECT( !!"coroutine: not available (no C++20 coroutines, or std::optional)" );
+#endif
+}
+
+// end of file
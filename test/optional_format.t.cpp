@@ -0,0 +1,112 @@
+//
+// Copyright 2026 by Martin Moene
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "optional-main.t.hpp"
+#include "nonstd/optional_format.hpp"
+
+#if optional_HAVE_CHARCONV
+
+#include <cstring>
+#include <string>
+
+using namespace nonstd;
+
+namespace format {
+
+template< typename T, typename... Args >
+std::string write( optional<T> const & x, Args... args )
+{
+    char buffer[ 32 ];
+    std::to_chars_result const r = to_chars( buffer, buffer + sizeof( buffer ), x, args... );
+
+    return r.ec == std::errc() ? std::string( buffer, r.ptr ) : std::string( "error" );
+}
+
+} // namespace format
+
+#endif
+
+CASE( "to_chars: Writes the value of an optional or a null token (C++17)" )
+{
+#if optional_HAVE_CHARCONV
+    EXPECT( format::write( optional<int>( 42 ) ) == "42" );
+    EXPECT( format::write( optional<int>() ) == "null" );
+    EXPECT( format::write( optional<int>(), "-" ) == "-" );
+    EXPECT( format::write( optional<int>(), "" ) == "" );
+    EXPECT( format::write( optional<unsigned>( 255u ), "-", 16 ) == "ff" );
+
+    char small[ 3 ];
+
+    EXPECT( ( to_chars( small, small + 3, optional<long>() ).ec == std::errc::value_too_large ) );
+    EXPECT( ( to_chars( small, small + 3, optional<long>( 1234 ) ).ec == std::errc::value_too_large ) );
+#else
+    EXPECT( !!"to_chars: not available (no C++17 <charconv>)" );
+#endif
+}
+
+CASE( "to_chars: Writes the value of an optional floating-point value (C++17)" )
+{
+#if optional_HAVE_CHARCONV && optional_HAVE_CHARCONV_FLOAT
+    EXPECT( format::write( optional<double>( 0.25 ) ) == "0.25" );
+    EXPECT( format::write( optional<double>( 0.25 ), "NA", std::chars_format::scientific ) == "2.5e-01" );
+    EXPECT( format::write( optional<float>(), "NA" ) == "NA" );
+#else
+    EXPECT( !!"to_chars: floating point not available (no C++17 <charconv>, or no floating-point support)" );
+#endif
+}
+
+CASE( "from_chars: Reads a value or a null token into an optional (C++17)" )
+{
+#if optional_HAVE_CHARCONV
+    char const text[] = "17 null ff x";
+
+    optional<int> x;
+    std::from_chars_result r = from_chars( text, text + 2, x );
+
+    EXPECT( ( r.ec == std::errc() ) );
+    EXPECT( x.value() == 17 );
+
+    r = from_chars( text + 3, text + 7, x );
+
+    EXPECT( ( r.ec == std::errc() ) );
+    EXPECT( ( r.ptr == text + 7 ) );
+    EXPECT( !x );
+
+    r = from_chars( text + 8, text + 10, x, "null", 16 );
+
+    EXPECT( x.value() == 255 );
+
+    r = from_chars( text + 11, text + 12, x );
+
+    EXPECT( ( r.ec == std::errc::invalid_argument ) );
+    EXPECT( x.value() == 255 );
+
+    r = from_chars( text, text, x, "" );
+
+    EXPECT( ( r.ec == std::errc() ) );
+    EXPECT( !x );
+#else
+    EXPECT( !!"from_chars: not available (no C++17 <charconv>)" );
+#endif
+}
+
+CASE( "std::format: Formats an optional with a null token (C++20)" )
+{
+#if optional_HAVE_CHARCONV && optional_USES_STD_FORMAT
+    optional<int> const a( 42 );
+    optional<int> const e;
+
+    EXPECT( std::format( "{}", a ) == "42" );
+    EXPECT( std::format( "{}", e ) == "null" );
+    EXPECT( std::format( "{:'-'}", e ) == "-" );
+    EXPECT( std::format( "{:'-'>4}", a ) == "  42" );
+    EXPECT( std::format( "{:'n/a'.1f}", optional<double>( 2.25 ) ) == "2.2" );
+#else
+    EXPECT( !!"std::format: not available (no C++20 <format>, or std::optional)" );
+#endif
+}
+
+// end of file
@@ -0,0 +1,145 @@
+//
+// Copyright 2026 by Martin Moene
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "optional-main.t.hpp"
+
+#if optional_USES_INSTRUMENT && !optional_USES_STD_OPTIONAL
+
+#include <thread>
+
+using namespace nonstd;
+
+namespace instrumented {
+
+struct Payload
+{
+    int v;
+    Payload( int x ) : v( x ) {}
+};
+
+inline instrument::stats stats_of_payload()
+{
+    std::vector< instrument::stats > const all = instrument::snapshot();
+
+    for ( instrument::stats const & s : all )
+    {
+        if ( s.type.find( "Payload" ) != std::string::npos )
+            return s;
+    }
+    return instrument::stats();
+}
+
+} // namespace instrumented
+
+#endif
+
+CASE( "instrument: Counts constructions, assignments, emplace, reset and destructions (C++11)" )
+{
+#if optional_USES_INSTRUMENT && !optional_USES_STD_OPTIONAL
+    using instrumented::Payload;
+
+    instrument::reset();
+    {
+        optional<Payload> a;
+        optional<Payload> b( Payload( 1 ) );
+        optional<Payload> c( b );
+        optional<Payload> d( std::move( c ) );
+
+        a = b;
+        a = std::move( d );
+        a = Payload( 2 );
+        a.emplace( 3 );
+        a.reset();
+        a = nullopt;
+    }
+    instrument::stats const s = instrumented::stats_of_payload();
+
+    EXPECT( s.count[ instrument::default_construction ] == 1u );
+    EXPECT( s.count[ instrument::value_construction   ] == 1u );
+    EXPECT( s.count[ instrument::copy_construction    ] == 1u );
+    EXPECT( s.count[ instrument::move_construction    ] == 1u );
+    EXPECT( s.count[ instrument::copy_assignment      ] == 1u );
+    EXPECT( s.count[ instrument::move_assignment      ] == 1u );
+    EXPECT( s.count[ instrument::value_assignment     ] == 1u );
+    EXPECT( s.count[ instrument::emplace_call         ] == 1u );
+    EXPECT( s.count[ instrument::reset_call           ] == 2u );
+    EXPECT( s.count[ instrument::destruction          ] == 4u );
+    EXPECT( s.count[ instrument::engaged_destruction  ] == 3u );
+    EXPECT( s.engaged_at_destruction() == 0.75 );
+#else
+    EXPECT( !!"instrument: not enabled (optional_CONFIG_INSTRUMENT, nonstd::optional, C++11)" );
+#endif
+}
+
+CASE( "instrument: Counts bad_optional_access throws (C++11)" )
+{
+#if optional_USES_INSTRUMENT && !optional_USES_STD_OPTIONAL && !optional_CONFIG_NO_EXCEPTIONS
+    using instrumented::Payload;
+
+    instrument::reset();
+
+    optional<Payload> const e;
+
+    EXPECT_THROWS_AS( e.value(), bad_optional_access );
+    EXPECT( instrumented::stats_of_payload().count[ instrument::bad_access ] == 1u );
+#else
+    EXPECT( !!"instrument: not enabled (optional_CONFIG_INSTRUMENT, nonstd::optional, C++11, exceptions)" );
+#endif
+}
+
+CASE( "instrument: Aggregates the counts of all threads, also of ended ones (C++11)" )
+{
+#if optional_USES_INSTRUMENT && !optional_USES_STD_OPTIONAL
+    using instrumented::Payload;
+
+    instrument::reset();
+
+    std::vector< std::thread > threads;
+
+    for ( int t = 0; t < 4; ++t )
+    {
+        threads.emplace_back( []()
+        {
+            for ( int i = 0; i < 1000; ++i )
+            {
+                optional<Payload> o{ Payload( i ) };
+            }
+        });
+    }
+
+    for ( std::thread & t : threads )
+    {
+        t.join();
+    }
+
+    EXPECT( instrumented::stats_of_payload().count[ instrument::value_construction ] == 4000u );
+#else
+    EXPECT( !!"instrument: not enabled (optional_CONFIG_INSTRUMENT, nonstd::optional, C++11)" );
+#endif
+}
+
+CASE( "instrument: Dumps the counts as text and as JSON (C++11)" )
+{
+#if optional_USES_INSTRUMENT && !optional_USES_STD_OPTIONAL
+    using instrumented::Payload;
+
+    instrument::reset();
+    {
+        optional<Payload> o( Payload( 7 ) );
+    }
+    std::string const text = instrument::report( instrument::text );
+    std::string const json = instrument::report( instrument::json );
+
+    EXPECT( text.find( "Payload>:"                 ) != std::string::npos );
+    EXPECT( text.find( "value_construction: 1"     ) != std::string::npos );
+    EXPECT( json.find( "\"value_construction\": 1" ) != std::string::npos );
+    EXPECT( json.find( "\"engaged_at_destruction\": 1" ) != std::string::npos );
+#else
+    EXPECT( !!"instrument: not enabled (optional_CONFIG_INSTRUMENT, nonstd::optional, C++11)" );
+#endif
+}
+
+// end of file
@@ -0,0 +1,79 @@
+//
+// Copyright 2026 by Martin Moene
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "optional-main.t.hpp"
+
+#if optional_USES_LAYOUT_AUDIT && !optional_USES_STD_OPTIONAL
+
+using namespace nonstd;
+
+namespace audited {
+
+struct Wide   { double d; };
+struct Narrow { char c; };
+
+inline layout::entry entry_of( std::string const & name )
+{
+    std::vector< layout::entry > const all = layout::entries();
+
+    for ( std::size_t i = 0; i < all.size(); ++i )
+    {
+        if ( all[i].type.find( name ) != std::string::npos )
+            return all[i];
+    }
+    return layout::entry();
+}
+
+inline std::size_t position_of( std::string const & name )
+{
+    std::vector< layout::entry > const all = layout::entries();
+
+    for ( std::size_t i = 0; i < all.size(); ++i )
+    {
+        if ( all[i].type.find( name ) != std::string::npos )
+            return i;
+    }
+    return all.size();
+}
+
+} // namespace audited
+
+#endif
+
+CASE( "layout: Registers size, alignment, payload size and padding of instantiated optionals" )
+{
+#if optional_USES_LAYOUT_AUDIT && !optional_USES_STD_OPTIONAL
+    using audited::Wide;
+    using audited::Narrow;
+
+    optional<Wide>   w;
+    optional<Narrow> n;
+
+    layout::entry const ew = audited::entry_of( "Wide"   );
+    layout::entry const en = audited::entry_of( "Narrow" );
+
+    EXPECT( ew.size    == sizeof( optional<Wide> ) );
+    EXPECT( ew.payload == sizeof( Wide ) );
+    EXPECT( ew.waste   == sizeof( optional<Wide> ) - sizeof( Wide ) - 1 );
+    EXPECT( en.size    == 2u );
+    EXPECT( en.align   == 1u );
+    EXPECT( en.waste   == 0u );
+#else
+    EXPECT( !!"layout: not enabled (optional_CONFIG_LAYOUT_AUDIT, nonstd::optional)" );
+#endif
+}
+
+CASE( "layout: Reports the optionals that waste most bytes first" )
+{
+#if optional_USES_LAYOUT_AUDIT && !optional_USES_STD_OPTIONAL
+    EXPECT( audited::position_of( "Wide" ) < audited::position_of( "Narrow" ) );
+    EXPECT( layout::report().find( "optional<audited::Wide>" ) != std::string::npos );
+#else
+    EXPECT( !!"layout: not enabled (optional_CONFIG_LAYOUT_AUDIT, nonstd::optional)" );
+#endif
+}
+
+// end of file
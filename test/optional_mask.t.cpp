@@ -0,0 +1,88 @@
+//
+// Copyright 2026 by Martin Moene
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "optional-main.t.hpp"
+#include "nonstd/optional_mask.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+using namespace nonstd;
+
+namespace mask {
+
+// elements 0..n-1, engaged where i % 3 == 0 or i == 64:
+
+std::vector< optional<int> > sample( int n )
+{
+    std::vector< optional<int> > v( static_cast<std::size_t>( n ) );
+
+    for ( int i = 0; i < n; ++i )
+    {
+        if ( i % 3 == 0 || i == 64 ) v[ static_cast<std::size_t>( i ) ] = i;
+    }
+    return v;
+}
+
+} // namespace mask
+
+#endif
+
+CASE( "engaged_mask: Provides a bitmap of the engaged optionals of a range (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    std::vector< optional<int> > const v = mask::sample( 70 );
+    std::vector<std::uint64_t> const m = engaged_mask( v );
+
+    EXPECT( m.size() == 2u );
+    EXPECT( m[0] == 0x9249249249249249ull );
+    EXPECT( m[1] == 0x0000000000000025ull );
+    EXPECT( ( engaged_mask( v.begin(), v.begin() + 3 ) == std::vector<std::uint64_t>{ 1 } ) );
+    EXPECT( engaged_mask( v.begin(), v.begin() ).empty() );
+#else
+    EXPECT( !!"engaged_mask: not available (no C++11)" );
+#endif
+}
+
+CASE( "count_engaged: Counts the engaged optionals of a range (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    std::vector< optional<int> > const v = mask::sample( 200 );
+    std::array< optional<char>, 3 > const a = {{ 'a', nullopt, 'c' }};
+
+    EXPECT( count_engaged( v ) == 68u );
+    EXPECT( count_engaged( v.begin() + 1, v.begin() + 3 ) == 0u );
+    EXPECT( count_engaged( a ) == 2u );
+#else
+    EXPECT( !!"count_engaged: not available (no C++11)" );
+#endif
+}
+
+CASE( "for_each_engaged: Visits the values of the engaged optionals of a range in order (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    std::vector< optional<int> > v = mask::sample( 130 );
+    std::vector<int> visited;
+
+    for_each_engaged( v, [&]( int x ) { visited.push_back( x ); } );
+
+    EXPECT( visited.size() == count_engaged( v ) );
+    EXPECT( visited[21] == 63 );
+    EXPECT( visited[22] == 64 );
+    EXPECT( visited.back() == 129 );
+
+    for_each_engaged( v.begin(), v.end(), []( int & x ) { x = -x; } );
+
+    EXPECT( *v[129] == -129 );
+#else
+    EXPECT( !!"for_each_engaged: not available (no C++11)" );
+#endif
+}
+
+// end of file
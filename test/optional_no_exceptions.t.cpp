@@ -0,0 +1,35 @@
+//
+// Copyright 2026 by Martin Moene
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compiled with exceptions disabled (e.g. -fno-exceptions), without lest:
+
+#include "nonstd/optional_sort.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace nonstd;
+
+int main()
+{
+    std::vector< optional<int> > v( 100000 );
+
+    for ( std::size_t i = 0; i < v.size(); ++i )
+    {
+        if ( i % 3 != 0 )
+        {
+            v[i] = static_cast<int>( ( i * 7919 ) % 1000 );
+        }
+    }
+
+    std::size_t const engaged = parallel::count_engaged( v.begin(), v.end(), 4 );
+
+    parallel::radix_sort( v.begin(), v.end(), empties_first, 4 );
+
+    return engaged == 66666u && std::is_sorted( v.begin(), v.end() ) ? 0 : 1;
+}
+
+// g++ -std=c++11 -Wall -fno-exceptions -pthread -I../include -o optional_no_exceptions.t optional_no_exceptions.t.cpp && optional_no_exceptions.t
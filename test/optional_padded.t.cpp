@@ -0,0 +1,122 @@
+//
+// Copyright 2026 by Martin Moene
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "optional-main.t.hpp"
+#include "nonstd/optional_padded.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace nonstd;
+
+namespace padded {
+
+struct Block { char data[ 100 ]; };
+
+} // namespace padded
+
+#endif
+
+CASE( "padded_optional: Occupies whole cache lines (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    EXPECT( alignof( padded_optional<char> ) == std::size_t( optional_CONFIG_CACHE_LINE_SIZE ) );
+    EXPECT( sizeof( padded_optional<char> ) == std::size_t( optional_CONFIG_CACHE_LINE_SIZE ) );
+    EXPECT( sizeof( padded_optional<padded::Block> ) % optional_CONFIG_CACHE_LINE_SIZE == 0u );
+#else
+    EXPECT( !!"padded_optional: not available (no C++11)" );
+#endif
+}
+
+CASE( "padded_optional: Allows to use as optional (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    padded_optional<std::string> p;
+
+    EXPECT( !p );
+
+    p = "hello";
+    EXPECT( *p == "hello" );
+    EXPECT( p == std::string( "hello" ) );
+
+    padded_optional<std::string> q( in_place, "xxx" );
+    EXPECT( q.value() == "xxx" );
+
+    padded_optional<std::string> r( optional<std::string>( "r" ) );
+    optional<std::string> const o = r;
+    EXPECT( *o == "r" );
+
+    p.reset();
+    EXPECT( !p );
+
+    padded_optional<std::string> const e;
+    EXPECT( e.value_or( "none" ) == "none" );
+#else
+    EXPECT( !!"padded_optional: not available (no C++11)" );
+#endif
+}
+
+CASE( "per_thread_optional: Provides aligned slots, one per thread (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    per_thread_optional<int> const d;
+    per_thread_optional<int> s( 5 );
+
+    EXPECT( d.size() >= 1u );
+    EXPECT( s.size() == 5u );
+    EXPECT( s.count_engaged() == 0u );
+
+    for ( auto const & slot : s )
+    {
+        EXPECT( reinterpret_cast<std::uintptr_t>( &slot ) % optional_CONFIG_CACHE_LINE_SIZE == 0u );
+    }
+#else
+    EXPECT( !!"per_thread_optional: not available (no C++11)" );
+#endif
+}
+
+CASE( "per_thread_optional: Allows to combine and reduce the results of threads (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    per_thread_optional<long> s( 4 );
+    std::vector<std::thread> threads;
+
+    for ( std::size_t t = 0; t < s.size(); ++t )
+    {
+        threads.emplace_back( [&s, t]
+        {
+            if ( t == 2 ) return;
+
+            for ( long i = 0; i < 1000; ++i )
+            {
+                s[t] = s[t].value_or( 0 ) + long( t + 1 );
+            }
+        } );
+    }
+
+    for ( auto & thread : threads )
+    {
+        thread.join();
+    }
+
+    EXPECT( s.count_engaged() == 3u );
+    EXPECT( s.combine( []( long a, long b ) { return a + b; } ).value() == 1000 + 2000 + 4000 );
+    EXPECT( s.reduce( std::string(), []( std::string a, long x ) { return a + std::to_string( x ) + ";"; } ) == "1000;2000;4000;" );
+
+    s.reset();
+
+    EXPECT( !s.combine( []( long a, long b ) { return a + b; } ) );
+    EXPECT( s.reduce( 7, []( int a, long x ) { return a + int( x ); } ) == 7 );
+#else
+    EXPECT( !!"per_thread_optional: not available (no C++11)" );
+#endif
+}
+
+// end of file
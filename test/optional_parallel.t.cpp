@@ -0,0 +1,133 @@
+//
+// Copyright 2026 by Martin Moene
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "optional-main.t.hpp"
+#include "nonstd/optional_parallel.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+using namespace nonstd;
+
+namespace par {
+
+// large enough for several chunks; every third element empty:
+
+std::vector< optional<double> > column( std::size_t n = 100000 )
+{
+    std::vector< optional<double> > v( n );
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        if ( i % 3 ) v[i] = 1.0 / static_cast<double>( i + 1 );
+    }
+    return v;
+}
+
+bool same_bits( double a, double b )
+{
+    return std::memcmp( &a, &b, sizeof( double ) ) == 0;
+}
+
+} // namespace par
+
+#endif
+
+CASE( "parallel: Allows to count the engaged optionals of a range (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    std::vector< optional<double> > const v = par::column();
+
+    EXPECT( parallel::count_engaged( v.begin(), v.end(), 1 ) == 66666u );
+    EXPECT( parallel::count_engaged( v.begin(), v.end(), 4 ) == 66666u );
+    EXPECT( parallel::count_engaged( v.begin(), v.begin(), 4 ) == 0u );
+#else
+    EXPECT( !!"parallel: not available (no C++11)" );
+#endif
+}
+
+CASE( "parallel: Allows to sum the engaged values of a range with the same result for any number of threads (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    std::vector< optional<double> > const v = par::column();
+
+    double const one = parallel::sum_engaged( v.begin(), v.end(), 1 );
+
+    EXPECT( par::same_bits( one, parallel::sum_engaged( v.begin(), v.end(), 2 ) ) );
+    EXPECT( par::same_bits( one, parallel::sum_engaged( v.begin(), v.end(), 3 ) ) );
+    EXPECT( par::same_bits( one, parallel::sum_engaged( v.begin(), v.end(), 7 ) ) );
+    EXPECT( parallel::sum_engaged( v.begin(), v.begin() ) == 0.0 );
+#else
+    EXPECT( !!"parallel: not available (no C++11)" );
+#endif
+}
+
+CASE( "parallel: Allows to obtain the least and greatest engaged value of a range (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    std::vector< optional<double> > const v = par::column();
+    std::vector< optional<double> > const none( 10 );
+
+    EXPECT( parallel::min_engaged( v.begin(), v.end(), 4 ).value() == 1.0 / 99999 );
+    EXPECT( parallel::max_engaged( v.begin(), v.end(), 4 ).value() == 0.5 );
+    EXPECT( !parallel::min_engaged( none.begin(), none.end() ) );
+    EXPECT( !parallel::max_engaged( none.begin(), none.end() ) );
+#else
+    EXPECT( !!"parallel: not available (no C++11)" );
+#endif
+}
+
+CASE( "parallel: Allows to transform the engaged values of a range (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    std::vector< optional<double> > const v = par::column();
+    std::vector< optional<long> > out( v.size(), 7L );
+
+    auto const end = parallel::transform_engaged( v.begin(), v.end(), out.begin(), []( double x ) { return static_cast<long>( 1 / x ); }, 4 );
+
+    EXPECT( end - out.begin() == 100000 );
+
+    EXPECT( !out[0] );
+    EXPECT( out[1].value() == 2L );
+    EXPECT( out[99998].value() == 99999L );
+    EXPECT( parallel::count_engaged( out.begin(), out.end() ) == 66666u );
+#else
+    EXPECT( !!"parallel: not available (no C++11)" );
+#endif
+}
+
+CASE( "parallel: Allows to fill the empty optionals of a range (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    std::vector< optional<double> > v = par::column();
+
+    parallel::fill_empty( v.begin(), v.end(), -1.0, 4 );
+
+    EXPECT( parallel::count_engaged( v.begin(), v.end() ) == v.size() );
+    EXPECT( v[0].value() == -1.0 );
+    EXPECT( v[1].value() ==  0.5 );
+#else
+    EXPECT( !!"parallel: not available (no C++11)" );
+#endif
+}
+
+CASE( "parallel: Rethrows an exception of a thread on the calling thread (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    std::vector< optional<double> > const v = par::column();
+    std::vector< optional<double> > out( v.size() );
+
+    EXPECT_THROWS_AS( parallel::transform_engaged( v.begin(), v.end(), out.begin(),
+        []( double x ) -> double { if ( x < 1e-4 ) throw std::range_error( "small" ); return x; }, 4 ), std::range_error );
+#else
+    EXPECT( !!"parallel: not available (no C++11)" );
+#endif
+}
+
+// end of file
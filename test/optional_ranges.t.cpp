@@ -0,0 +1,126 @@
+//
+// Copyright 2026 by Martin Moene
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "optional-main.t.hpp"
+#include "nonstd/optional_ranges.hpp"
+
+using namespace nonstd;
+
+#if optional_CPP11_OR_GREATER
+
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace ranges {
+
+std::vector< optional<int> > sample()
+{
+    return { 1, nullopt, 3, nullopt, nullopt, 6 };
+}
+
+template< typename Range >
+bool equals( Range && r, std::initializer_list<int> expected )
+{
+    std::vector<int> result;
+    for ( auto && x : r )
+    {
+        result.push_back( x );
+    }
+    return result == std::vector<int>( expected );
+}
+
+} // namespace ranges
+
+#endif
+
+CASE( "optional: Allows to iterate over the value of an optional as a range of zero or one element [extension]" )
+{
+#if !optional_USES_STD_OPTIONAL && !optional_CONFIG_NO_EXTENSIONS
+    optional<int> e( 42 );
+    optional<int> const d;
+
+    EXPECT( e.end() - e.begin() == 1 );
+    EXPECT( d.end() - d.begin() == 0 );
+    EXPECT( *e.begin() == 42 );
+
+    *e.begin() = 7;
+
+    EXPECT( *e == 7 );
+#else
+    EXPECT( !!"optional: begin(), end() are not available (std::optional, or no extensions)" );
+#endif
+}
+
+CASE( "views: Allows to visit the engaged optionals of a range (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    std::vector< optional<int> > v = ranges::sample();
+    std::vector<int> values;
+
+    for ( auto & o : views::engaged( v ) )
+    {
+        values.push_back( *o );
+    }
+
+    EXPECT( ranges::equals( values, { 1, 3, 6 } ) );
+#else
+    EXPECT( !!"views: not available (no C++11)" );
+#endif
+}
+
+CASE( "views: Allows to visit the values of the engaged optionals of a range (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    std::vector< optional<int> > v = ranges::sample();
+    std::vector< optional<int> > const none( 3 );
+
+    EXPECT( ranges::equals( views::values( v ), { 1, 3, 6 } ) );
+    EXPECT( ranges::equals( views::values( none ), {} ) );
+
+    for ( auto & x : views::values( v ) )
+    {
+        x *= 10;
+    }
+
+    EXPECT( *v[5] == 60 );
+#else
+    EXPECT( !!"views: not available (no C++11)" );
+#endif
+}
+
+CASE( "views: Allows to visit the value or a default of each optional of a range (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    std::vector< optional<int> > const v = ranges::sample();
+
+    EXPECT( ranges::equals( views::values_or( v, 0 ), { 1, 0, 3, 0, 0, 6 } ) );
+#else
+    EXPECT( !!"views: not available (no C++11)" );
+#endif
+}
+
+CASE( "views: Allows to compose views with C++20 ranges (C++20)" )
+{
+#if optional_CPP11_OR_GREATER && optional_USES_STD_RANGES
+    std::vector< optional<int> > const v = ranges::sample();
+
+    auto squares = v | views::values | std::views::transform( []( int x ) { return x * x; } );
+
+    EXPECT( ranges::equals( squares, { 1, 9, 36 } ) );
+    EXPECT( ranges::equals( v | views::values_or( -1 ) | std::views::take( 2 ), { 1, -1 } ) );
+    EXPECT( std::ranges::distance( v | views::engaged ) == 3 );
+
+    auto parse = []( char c ) { return c >= '0' && c <= '9' ? optional<int>( c - '0' ) : nullopt; };
+    std::string const text = "a1b2c3";
+
+    EXPECT( ranges::equals( text | std::views::transform( parse ) | views::values, { 1, 2, 3 } ) );
+#else
+    EXPECT( !!"views: C++20 composition not available (no C++20 ranges)" );
+#endif
+}
+
+// end of file
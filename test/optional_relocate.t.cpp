@@ -0,0 +1,168 @@
+//
+// Copyright 2026 by Martin Moene
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "optional-main.t.hpp"
+#include "nonstd/optional_relocate.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <memory>
+#include <string>
+
+using namespace nonstd;
+
+namespace relocate {
+
+// A type that is trivially relocatable by opt-in and counts its moves:
+
+struct Counted
+{
+    static int & moves() { static int n = 0; return n; }
+
+    std::unique_ptr<int> p;
+
+    explicit Counted( int v ) : p( new int( v ) ) {}
+    Counted( Counted && other ) noexcept : p( std::move( other.p ) ) { ++moves(); }
+};
+
+// A type that is not trivially relocatable and counts its moves:
+
+struct Tracked
+{
+    static int & moves() { static int n = 0; return n; }
+
+    int v;
+
+    explicit Tracked( int x ) : v( x ) {}
+    Tracked( Tracked && other ) noexcept : v( other.v ) { ++moves(); }
+    Tracked( Tracked const & other ) : v( other.v ) {}
+};
+
+} // namespace relocate
+
+namespace nonstd {
+
+template<>
+struct is_trivially_relocatable< relocate::Counted > : std::true_type{};
+
+} // namespace nonstd
+
+#endif
+
+CASE( "is_trivially_relocatable: Propagates from the payload to optional (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    EXPECT(     is_trivially_relocatable< optional<int> >::value );
+    EXPECT(     is_trivially_relocatable< optional< std::unique_ptr<int> > >::value );
+    EXPECT(     is_trivially_relocatable< optional< relocate::Counted > >::value );
+    EXPECT_NOT( is_trivially_relocatable< optional< relocate::Tracked > >::value );
+    EXPECT_NOT( is_trivially_relocatable< optional< std::string > >::value );
+#else
+    EXPECT( !!"is_trivially_relocatable: not available (no C++11)" );
+#endif
+}
+
+CASE( "relocate_at: Allows to relocate an optional to uninitialized storage (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    typedef optional< std::unique_ptr<int> > opt;
+
+    opt * src = new opt( std::unique_ptr<int>( new int( 7 ) ) );
+    void * raw = ::operator new( sizeof( opt ) );
+
+    opt * dst = relocate_at( src, static_cast<opt *>( raw ) );
+    ::operator delete( static_cast<void *>( src ) );
+
+    EXPECT( dst->has_value() );
+    EXPECT( *dst->value() == 7 );
+
+    dst->~opt();
+    ::operator delete( raw );
+#else
+    EXPECT( !!"relocate_at: not available (no C++11)" );
+#endif
+}
+
+CASE( "uninitialized_relocate: Allows to relocate a range of non-trivially relocatable optionals (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    typedef optional< std::string > opt;
+
+    std::allocator<opt> alloc;
+    opt * src = alloc.allocate( 3 );
+    opt * dst = alloc.allocate( 3 );
+
+    ::new( src + 0 ) opt( "a" );
+    ::new( src + 1 ) opt();
+    ::new( src + 2 ) opt( "c" );
+
+    EXPECT( uninitialized_relocate( src, src + 3, dst ) == dst + 3 );
+
+    EXPECT( *dst[0] == "a" );
+    EXPECT( !dst[1].has_value() );
+    EXPECT( *dst[2] == "c" );
+
+    for ( int i = 0; i < 3; ++i ) dst[i].~opt();
+    alloc.deallocate( src, 3 );
+    alloc.deallocate( dst, 3 );
+#else
+    EXPECT( !!"uninitialized_relocate: not available (no C++11)" );
+#endif
+}
+
+CASE( "relocating_vector: Relocates trivially relocatable optionals on growth without moving them (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    using relocate::Counted;
+
+    relocating_vector< optional<Counted> > v;
+
+    for ( int i = 0; i < 100; ++i )
+    {
+        if ( i % 2 ) v.emplace_back( Counted( i ) );
+        else         v.emplace_back();
+    }
+
+    Counted::moves() = 0;
+    v.reserve( 1000 );
+
+    EXPECT( Counted::moves() == 0 );
+    EXPECT( v.size() == 100u );
+    EXPECT( !v[0].has_value() );
+    EXPECT( *v[99]->p == 99 );
+#else
+    EXPECT( !!"relocating_vector: not available (no C++11)" );
+#endif
+}
+
+CASE( "relocating_vector: Moves other optionals on growth (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    using relocate::Tracked;
+
+    relocating_vector< optional<Tracked> > v;
+
+    for ( int i = 0; i < 10; ++i )
+    {
+        v.emplace_back( Tracked( i ) );
+    }
+
+    Tracked::moves() = 0;
+    v.reserve( 100 );
+
+    EXPECT( Tracked::moves() == 10 );
+    EXPECT( v.back()->v == 9 );
+
+    relocating_vector< optional<Tracked> > w( v );
+
+    EXPECT( w.size() == 10u );
+    EXPECT( w.front()->v == 0 );
+#else
+    EXPECT( !!"relocating_vector: not available (no C++11)" );
+#endif
+}
+
+// end of file
@@ -0,0 +1,168 @@
+//
+// Copyright 2026 by Martin Moene
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "optional-main.t.hpp"
+#include "nonstd/optional_shared.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace nonstd;
+
+namespace shared {
+
+// a value that is consistent if all its fields are equal:
+
+struct Snapshot
+{
+    long field[ 37 ];
+
+    explicit Snapshot( long v = 0 )
+    {
+        for ( auto & f : field ) f = v;
+    }
+
+    bool consistent() const
+    {
+        for ( auto f : field ) if ( f != field[0] ) return false;
+        return true;
+    }
+};
+
+} // namespace shared
+
+#endif
+
+CASE( "shared_optional: Allows to store, load and reset a value (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    shared_optional<shared::Snapshot> s;
+
+    EXPECT( !s.has_value() );
+    EXPECT( !s.load() );
+
+    s.store( shared::Snapshot( 7 ) );
+
+    EXPECT( s.has_value() );
+    EXPECT( s.load()->field[36] == 7 );
+
+    s.emplace( 8 );
+    EXPECT( s.load()->field[0] == 8 );
+
+    s = nullopt;
+    EXPECT( !s.load() );
+    EXPECT( s.value_or( shared::Snapshot( 9 ) ).field[0] == 9 );
+
+    s.store( optional<shared::Snapshot>( shared::Snapshot( 1 ) ) );
+    EXPECT( s.load()->field[0] == 1 );
+    EXPECT( s.version() == 4u );
+#else
+    EXPECT( !!"shared_optional: not available (no C++11)" );
+#endif
+}
+
+CASE( "shared_optional: Allows to construct with a value (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    shared_optional<int> const e( nullopt );
+    shared_optional<int> const v( 42 );
+
+    EXPECT( !e.has_value() );
+    EXPECT( v.load().value() == 42 );
+    EXPECT( e.value_or( 3 ) == 3 );
+#else
+    EXPECT( !!"shared_optional: not available (no C++11)" );
+#endif
+}
+
+CASE( "shared_optional: Gives readers a consistent copy while a writer stores (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    shared_optional<shared::Snapshot> s( shared::Snapshot( 0 ) );
+    std::atomic<bool> done( false );
+    std::atomic<int> inconsistent( 0 );
+
+    std::vector<std::thread> readers;
+
+    for ( int r = 0; r < 3; ++r )
+    {
+        readers.emplace_back( [&]
+        {
+            while ( !done.load() )
+            {
+                optional<shared::Snapshot> const x = s.load();
+
+                if ( x && !x->consistent() )
+                {
+                    ++inconsistent;
+                }
+            }
+        } );
+    }
+
+    for ( long i = 1; i <= 20000; ++i )
+    {
+        if ( i % 7 ) s.store( shared::Snapshot( i ) );
+        else         s.reset();
+    }
+
+    done = true;
+
+    for ( auto & t : readers )
+    {
+        t.join();
+    }
+
+    EXPECT( inconsistent.load() == 0 );
+    EXPECT( s.load()->field[0] == 20000 );
+#else
+    EXPECT( !!"shared_optional: not available (no C++11)" );
+#endif
+}
+
+CASE( "shared_optional: Lets concurrent writers take turns (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    shared_optional<shared::Snapshot> s( shared::Snapshot( 0 ) );
+    std::atomic<int> inconsistent( 0 );
+    std::size_t const version = s.version();
+
+    std::vector<std::thread> writers;
+
+    for ( int w = 0; w < 3; ++w )
+    {
+        writers.emplace_back( [&, w]
+        {
+            for ( long i = 1; i <= 10000; ++i )
+            {
+                s.store( shared::Snapshot( w * 10000 + i ) );
+
+                optional<shared::Snapshot> const x = s.load();
+
+                if ( !x || !x->consistent() )
+                {
+                    ++inconsistent;
+                }
+            }
+        } );
+    }
+
+    for ( auto & t : writers )
+    {
+        t.join();
+    }
+
+    EXPECT( inconsistent.load() == 0 );
+    EXPECT( s.version() == version + 30000u );
+#else
+    EXPECT( !!"shared_optional: not available (no C++11)" );
+#endif
+}
+
+// end of file
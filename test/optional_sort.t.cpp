@@ -0,0 +1,109 @@
+//
+// Copyright 2026 by Martin Moene
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "optional-main.t.hpp"
+#include "nonstd/optional_sort.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace nonstd;
+
+namespace sorting {
+
+// values from generate( rng ), one in five empty:
+
+template< typename T, typename Generate >
+std::vector< optional<T> > sample( std::size_t n, Generate generate )
+{
+    std::mt19937_64 rng( 42 );
+    std::vector< optional<T> > v( n );
+
+    for ( auto & x : v )
+    {
+        if ( rng() % 5 ) x = generate( rng );
+    }
+    return v;
+}
+
+// radix_sort() sorts as std::sort() with optional's operator<:
+
+template< typename T >
+bool sorts_as_operator_less( std::vector< optional<T> > v )
+{
+    std::vector< optional<T> > expected( v );
+    std::sort( expected.begin(), expected.end() );
+
+    std::vector< optional<T> > parallel( v );
+
+    radix_sort( v.begin(), v.end() );
+    parallel::radix_sort( parallel.begin(), parallel.end(), empties_first, 3 );
+
+    return v == expected && parallel == expected;
+}
+
+} // namespace sorting
+
+#endif
+
+CASE( "radix_sort: Sorts optional integers as operator< (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    using sorting::sample;
+    using sorting::sorts_as_operator_less;
+
+    EXPECT( sorts_as_operator_less( sample<std::uint64_t>( 30000, []( std::mt19937_64 & r ) { return r(); } ) ) );
+    EXPECT( sorts_as_operator_less( sample<std::int32_t >( 30000, []( std::mt19937_64 & r ) { return static_cast<std::int32_t>( r() ); } ) ) );
+    EXPECT( sorts_as_operator_less( sample<std::int8_t  >( 30000, []( std::mt19937_64 & r ) { return static_cast<std::int8_t >( r() ); } ) ) );
+    EXPECT( sorts_as_operator_less( sample<bool         >( 100  , []( std::mt19937_64 & r ) { return r() % 2 == 0; } ) ) );
+    EXPECT( sorts_as_operator_less( sample<int          >( 0    , []( std::mt19937_64 & r ) { return static_cast<int>( r() ); } ) ) );
+#else
+    EXPECT( !!"radix_sort: not available (no C++11)" );
+#endif
+}
+
+CASE( "radix_sort: Sorts optional floating-point values as operator< (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    using sorting::sample;
+    using sorting::sorts_as_operator_less;
+
+    double const special[] = { 0.0, 1.0, -1.0, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+                               std::numeric_limits<double>::min(), -std::numeric_limits<double>::denorm_min() };
+
+    EXPECT( sorts_as_operator_less( sample<double>( 30000, [&]( std::mt19937_64 & r )
+    {
+        return r() % 10 ? std::uniform_real_distribution<double>( -1e6, 1e6 )( r ) : special[ r() % 7 ];
+    } ) ) );
+    EXPECT( sorts_as_operator_less( sample<float>( 30000, []( std::mt19937_64 & r )
+    {
+        return std::uniform_real_distribution<float>( -1e3f, 1e3f )( r );
+    } ) ) );
+#else
+    EXPECT( !!"radix_sort: not available (no C++11)" );
+#endif
+}
+
+CASE( "radix_sort: Allows to sort empty optionals last (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    std::vector< optional<int> > v = { 3, nullopt, -1, nullopt, 2 };
+    std::vector< optional<int> > const expected = { -1, 2, 3, nullopt, nullopt };
+
+    radix_sort( v.begin(), v.end(), empties_last );
+
+    EXPECT( ( v == expected ) );
+#else
+    EXPECT( !!"radix_sort: not available (no C++11)" );
+#endif
+}
+
+// end of file
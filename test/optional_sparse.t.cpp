@@ -0,0 +1,166 @@
+//
+// Copyright 2026 by Martin Moene
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "optional-main.t.hpp"
+#include "nonstd/optional_sparse.hpp"
+
+#if optional_CPP11_OR_GREATER
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace nonstd;
+
+namespace sparse {
+
+// copy throws for a negative value:
+
+struct Fragile
+{
+    int value;
+
+    explicit Fragile( int v ) : value( v ) {}
+    Fragile( Fragile && ) = default;
+    Fragile & operator=( Fragile && ) = default;
+    Fragile & operator=( Fragile const & ) = default;
+
+    Fragile( Fragile const & other )
+    : value( other.value )
+    {
+        if ( value < 0 )
+            throw std::runtime_error( "Fragile" );
+    }
+};
+
+} // namespace sparse
+
+#endif
+
+CASE( "sparse_optional_array: Allows to construct from and convert to a dense container (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    std::vector< optional<int> > const dense = { nullopt, 1, nullopt, nullopt, 4, nullopt };
+
+    sparse_optional_array<int> const s( dense.begin(), dense.end() );
+
+    EXPECT( s.size() == 6u );
+    EXPECT( s.count_engaged() == 2u );
+    EXPECT( s.count_empty() == 4u );
+    EXPECT( ( s.to_vector() == dense ) );
+    EXPECT( ( s.positions() == std::vector<std::size_t>{ 1, 4 } ) );
+    EXPECT( ( s.values() == std::vector<int>{ 1, 4 } ) );
+#else
+    EXPECT( !!"sparse_optional_array: not available (no C++11)" );
+#endif
+}
+
+CASE( "sparse_optional_array: Allows to access and modify elements by position (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    sparse_optional_array<std::string> s( 1000 );
+
+    s.set( 700, std::string( "c" ) );
+    s.set( 10, std::string( "a" ) );
+    s.set( 500, std::string( "b" ) );
+
+    EXPECT( s[10].value() == "a" );
+    EXPECT( s[500].value() == "b" );
+    EXPECT( s.has_value( 700 ) );
+    EXPECT( !s[11] );
+    EXPECT( !s.has_value( 999 ) );
+
+    s.set( 500, std::string( "B" ) );
+    s.reset( 10 );
+
+    EXPECT( s[500].value() == "B" );
+    EXPECT( !s[10] );
+    EXPECT( ( s.positions() == std::vector<std::size_t>{ 500, 700 } ) );
+#else
+    EXPECT( !!"sparse_optional_array: not available (no C++11)" );
+#endif
+}
+
+CASE( "sparse_optional_array: Allows to iterate over all elements in order (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    sparse_optional_array<int> const s = { 1, nullopt, 3, nullopt };
+
+    std::vector< optional<int> > seen;
+    for ( auto const & x : s )
+    {
+        seen.push_back( x );
+    }
+
+    EXPECT( ( seen == std::vector< optional<int> >{ 1, nullopt, 3, nullopt } ) );
+#else
+    EXPECT( !!"sparse_optional_array: not available (no C++11)" );
+#endif
+}
+
+CASE( "sparse_optional_array: Allows to resize, dropping the engaged elements beyond the new size (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    sparse_optional_array<int> s = { 1, nullopt, 3, 4 };
+
+    s.resize( 3 );
+    EXPECT( s.count_engaged() == 2u );
+
+    s.resize( 10 );
+    EXPECT( s.size() == 10u );
+    EXPECT( !s[9] );
+
+    s.push_back( 11 );
+    s.pop_back();
+    s.pop_back();
+
+    EXPECT( s.size() == 9u );
+    EXPECT( ( s == sparse_optional_array<int>{ 1, nullopt, 3, nullopt, nullopt, nullopt, nullopt, nullopt, nullopt } ) );
+#else
+    EXPECT( !!"sparse_optional_array: not available (no C++11)" );
+#endif
+}
+
+CASE( "sparse_optional_array: Leaves the array unchanged if setting an element throws (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    sparse_optional_array<sparse::Fragile> s( 10 );
+
+    s.set( 2, sparse::Fragile( 2 ) );
+    s.set( 8, sparse::Fragile( 8 ) );
+
+    EXPECT_THROWS_AS( s.set( 5, sparse::Fragile( -5 ) ), std::runtime_error );
+    EXPECT_THROWS_AS( s.push_back( sparse::Fragile( -10 ) ), std::runtime_error );
+
+    EXPECT( s.size() == 10u );
+    EXPECT( ( s.positions() == std::vector<std::size_t>{ 2, 8 } ) );
+    EXPECT( s.values().size() == 2u );
+    EXPECT( s[8]->value == 8 );
+    EXPECT( !s[5] );
+#else
+    EXPECT( !!"sparse_optional_array: not available (no C++11)" );
+#endif
+}
+
+CASE( "sparse_optional_array: Uses memory in proportion to the engaged elements (C++11)" )
+{
+#if optional_CPP11_OR_GREATER
+    sparse_optional_array<double> s( 1000000 );
+
+    for ( std::size_t i = 0; i < 1000000; i += 1000 )
+    {
+        s.set( i, 1.0 );
+    }
+    s.shrink_to_fit();
+
+    EXPECT( s.count_engaged() == 1000u );
+    EXPECT( s.memory_size() == 1000 * ( sizeof( std::size_t ) + sizeof( double ) ) );
+#else
+    EXPECT( !!"sparse_optional_array: not available (no C++11)" );
+#endif
+}
+
+// end of file